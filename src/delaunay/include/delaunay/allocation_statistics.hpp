@@ -0,0 +1,83 @@
+#ifndef DELAUNAY_ALLOCATION_STATISTICS_HPP
+#define DELAUNAY_ALLOCATION_STATISTICS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+namespace delaunay {
+    /**
+     * Memory resource counting the allocations passed on to an upstream resource,
+     * e.g. to measure the bytes per point of a triangulation.
+     * The counters are atomic, the resource is as thread safe as its upstream.
+     */
+    class AllocationStatistics : public std::pmr::memory_resource {
+      public:
+        /**
+         * Constructor
+         * @param upstream resource the allocations are passed on to
+         */
+        explicit AllocationStatistics(std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+        /**
+         * Resource the allocations are passed on to
+         * @return upstream resource
+         */
+        [[nodiscard]] auto upstream() const -> std::pmr::memory_resource *;
+
+        /**
+         * Bytes allocated and not yet deallocated
+         * @return bytes in use
+         */
+        [[nodiscard]] auto bytes_in_use() const -> std::size_t;
+
+        /**
+         * Highest number of bytes in use at once, since construction or the last reset_peak()
+         * @return peak bytes
+         */
+        [[nodiscard]] auto peak_bytes() const -> std::size_t;
+
+        /**
+         * Bytes allocated in total
+         * @return total bytes
+         */
+        [[nodiscard]] auto total_bytes() const -> std::size_t;
+
+        /**
+         * Number of allocations
+         * @return allocation count
+         */
+        [[nodiscard]] auto allocation_count() const -> std::size_t;
+
+        /**
+         * Number of deallocations
+         * @return deallocation count
+         */
+        [[nodiscard]] auto deallocation_count() const -> std::size_t;
+
+        /**
+         * Sets the peak to the bytes currently in use
+         */
+        void reset_peak();
+
+      private:
+        auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override;
+
+        void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+
+        [[nodiscard]] auto do_is_equal(std::pmr::memory_resource const &other) const noexcept -> bool override;
+
+        /**
+         * Resource the allocations are passed on to
+         */
+        std::pmr::memory_resource *upstream_resource;
+
+        std::atomic<std::size_t> in_use{0};
+        std::atomic<std::size_t> peak{0};
+        std::atomic<std::size_t> total{0};
+        std::atomic<std::size_t> allocations{0};
+        std::atomic<std::size_t> deallocations{0};
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_ALLOCATION_STATISTICS_HPP
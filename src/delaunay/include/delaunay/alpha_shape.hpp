@@ -0,0 +1,113 @@
+#ifndef DELAUNAY_ALPHA_SHAPE_HPP
+#define DELAUNAY_ALPHA_SHAPE_HPP
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/quad_edge.hpp"
+
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Alpha complex filtration of a triangulation.
+     *
+     * Every triangle and edge gets its critical alpha once (the radius of the smallest empty circle
+     * through its vertices), after which the alpha complex and its boundary (the alpha shape) can be queried
+     * for any alpha without rescanning all triangles:
+     *
+     * - a triangle is part of the complex if alpha >= its circumradius
+     * - an edge is part of the complex from its critical alpha on, and part of the boundary until
+     *   both of its triangles are part of the complex
+     *
+     * Triangles are kept sorted by their alpha, so the triangles of a complex are a prefix of that list.
+     * Boundary edges are kept sorted by the alpha they enter the complex, together with a max tree over the alpha
+     * they leave the boundary, so a query only descends into subtrees containing boundary edges.
+     */
+    class AlphaShape {
+      public:
+        /**
+         * Computes the filtration of the triangulation
+         * @param triangulation finished triangulation, must outlive this object
+         */
+        explicit AlphaShape(Delaunay &triangulation);
+
+        /**
+         * Gets the boundary of the alpha shape in O(log n + k log n) for k boundary edges
+         * @param alpha radius of the alpha ball
+         * @return boundary edges, oriented with the inside of the shape on their left
+         */
+        auto get_boundary(scalar_t alpha) -> std::vector<QuadEdge *>;
+
+        /**
+         * Gets the triangles of the alpha complex in O(log n)
+         * @param alpha radius of the alpha ball
+         * @return number of triangles in the complex, they are the first entries of get_sorted_faces()
+         */
+        [[nodiscard]] auto get_face_count(scalar_t alpha) const -> std::size_t;
+
+        /**
+         * All face ids, sorted by their critical alpha
+         * @return vector of face ids
+         */
+        auto get_sorted_faces() -> std::vector<std::size_t> const &;
+
+        /**
+         * Critical alpha of every triangle (its circumradius)
+         * @return vector of alphas, indexed by face id
+         */
+        auto get_face_alphas() -> std::vector<scalar_t> const &;
+
+      private:
+        /**
+         * Returns the alpha at which the left face of the edge enters the complex
+         * @param edge edge to check
+         * @return circumradius of the left face, infinity for the outer face
+         */
+        auto left_face_alpha(QuadEdge *edge) -> scalar_t;
+
+        /**
+         * Returns whether the left face of the edge is part of the complex
+         * @param edge edge to check
+         * @param alpha radius of the alpha ball
+         * @return false for the outer face
+         */
+        auto is_left_face_in_complex(QuadEdge *edge, scalar_t alpha) -> bool;
+
+        /**
+         * Critical alpha of every triangle, indexed by face id
+         */
+        std::vector<scalar_t> face_alphas;
+
+        /**
+         * Face ids sorted by alpha
+         */
+        std::vector<std::size_t> sorted_faces;
+
+        /**
+         * Alphas of sorted_faces, for binary search
+         */
+        std::vector<scalar_t> sorted_face_alphas;
+
+        /**
+         * Edges sorted by the alpha at which they enter the complex
+         */
+        std::vector<QuadEdge *> sorted_edges;
+
+        /**
+         * Alpha at which each edge of sorted_edges enters the complex
+         */
+        std::vector<scalar_t> edge_births;
+
+        /**
+         * Max tree (implicit binary tree, leaves starting at tree_leaves) over the alpha at which the
+         * edges of sorted_edges stop being boundary edges
+         */
+        std::vector<scalar_t> edge_deaths;
+
+        /**
+         * Index of the first leaf in edge_deaths
+         */
+        std::size_t tree_leaves;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_ALPHA_SHAPE_HPP
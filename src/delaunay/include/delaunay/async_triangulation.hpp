@@ -0,0 +1,143 @@
+#ifndef DELAUNAY_ASYNC_TRIANGULATION_HPP
+#define DELAUNAY_ASYNC_TRIANGULATION_HPP
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/double_buffer.hpp"
+#include "delaunay/point.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Thrown into the future of a submission that was replaced by a newer one before it finished
+     */
+    class TriangulationCancelled : public std::runtime_error {
+      public:
+        TriangulationCancelled();
+    };
+
+    /**
+     * Triangulates point sets on a background worker, so the caller (e.g. a frame loop) never waits for a build.
+     *
+     * Only the newest submission matters: submitting cancels the submission still waiting and
+     * asks the one in flight to stop at its next check. Finished triangulations are published to a
+     * double buffer, so latest() is a lock-free read that can be called every frame.
+     * Published triangulations are shared and must only be read.
+     */
+    class AsyncTriangulation {
+      public:
+        using result_t = std::shared_ptr<Delaunay>;
+        using callback_t = std::function<void(result_t const &)>;
+
+        /**
+         * Constructor, starts the worker
+         * @param resource memory resource of all triangulations, thread safe and outliving every published result
+         */
+        explicit AsyncTriangulation(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+        /**
+         * Destructor, cancels outstanding work and joins the worker
+         */
+        ~AsyncTriangulation();
+
+        /**
+         * Triangulates the points in the background
+         * @param points points to triangulate
+         * @return future of the triangulation, throws TriangulationCancelled if a newer submission replaced it
+         */
+        auto submit(std::vector<point_t> points) -> std::future<result_t>;
+
+        /**
+         * Triangulates the points in the background and calls the callback on the worker thread once published.
+         * The callback is not called if a newer submission replaced this one.
+         * @param points points to triangulate
+         * @param callback called with the finished triangulation
+         */
+        void submit(std::vector<point_t> points, callback_t callback);
+
+        /**
+         * Latest finished triangulation, lock free
+         * @return triangulation, nullptr if none finished yet
+         */
+        [[nodiscard]] auto latest() const -> result_t;
+
+        AsyncTriangulation(AsyncTriangulation &&other) = delete;
+        AsyncTriangulation(AsyncTriangulation const &other) = delete;
+        auto operator=(AsyncTriangulation &&other) -> AsyncTriangulation & = delete;
+        auto operator=(AsyncTriangulation const &other) -> AsyncTriangulation & = delete;
+
+      private:
+        /**
+         * A submitted point set
+         */
+        struct Job {
+            std::vector<point_t> points;
+            std::promise<result_t> promise;
+            callback_t callback;
+            std::shared_ptr<std::atomic<bool>> cancelled;
+        };
+
+        /**
+         * Replaces the waiting job and cancels the running one
+         * @param job the new job
+         */
+        void enqueue(Job job);
+
+        /**
+         * Worker loop, builds one job after the other
+         */
+        void work();
+
+        /**
+         * Memory resource of all triangulations
+         */
+        std::pmr::memory_resource *resource;
+
+        /**
+         * Latest finished triangulation
+         */
+        DoubleBuffer<Delaunay> results;
+
+        /**
+         * Guards pending, running and stopping
+         */
+        std::mutex mutex;
+
+        /**
+         * Signals a new job or stopping to the worker
+         */
+        std::condition_variable job_available;
+
+        /**
+         * Newest job, not started yet
+         */
+        std::optional<Job> pending;
+
+        /**
+         * Cancel flag of the job being built
+         */
+        std::shared_ptr<std::atomic<bool>> running;
+
+        /**
+         * Set by the destructor
+         */
+        bool stopping = false;
+
+        /**
+         * Background worker, started last
+         */
+        std::thread worker;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_ASYNC_TRIANGULATION_HPP
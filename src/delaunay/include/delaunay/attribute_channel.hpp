@@ -0,0 +1,243 @@
+#ifndef DELAUNAY_ATTRIBUTE_CHANNEL_HPP
+#define DELAUNAY_ATTRIBUTE_CHANNEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * How the values of points merged into one vertex (duplicates) are combined
+     */
+    enum class Reduction : std::uint8_t {
+        /**
+         * Value of the first occurrence, the origin of the vertex
+         */
+        FIRST,
+
+        /**
+         * Smallest value
+         */
+        MIN,
+
+        /**
+         * Largest value
+         */
+        MAX,
+
+        /**
+         * Sum of the values
+         */
+        SUM,
+
+        /**
+         * Arithmetic mean, accumulated in double
+         */
+        MEAN,
+    };
+
+    /**
+     * Type erased array of one value per vertex, owned by a Delaunay.
+     * Whenever the triangulation renumbers its vertices, it remaps all channels with the same permutation.
+     */
+    class AttributeChannel {
+      public:
+        /**
+         * Deleter for channels allocated from a memory resource
+         */
+        struct Deleter {
+            void operator()(AttributeChannel *channel) const {
+                channel->destroy();
+            }
+        };
+
+        /**
+         * Constructor
+         * @param name name the channel is registered under
+         * @param type type of the values
+         * @param reduction how values of merged vertices are combined
+         * @param resource memory resource for the name and the values
+         */
+        AttributeChannel(std::string_view name, std::type_info const &type, Reduction reduction,
+                         std::pmr::memory_resource *resource) :
+            channel_name(name, resource),
+            channel_type(&type),
+            channel_reduction(reduction) {}
+
+        virtual ~AttributeChannel() = default;
+
+        /**
+         * Name the channel is registered under
+         * @return name
+         */
+        [[nodiscard]] auto name() const -> std::string_view {
+            return channel_name;
+        }
+
+        /**
+         * Type of the values
+         * @return type info
+         */
+        [[nodiscard]] auto type() const -> std::type_info const & {
+            return *channel_type;
+        }
+
+        /**
+         * How values of merged vertices are combined
+         * @return reduction
+         */
+        [[nodiscard]] auto reduction() const -> Reduction {
+            return channel_reduction;
+        }
+
+        /**
+         * Renumbers the values. Every new index takes the value of its origin, combined with the values
+         * of all other old indices mapped to it by the reduction.
+         * @param origins first old index of every new index
+         * @param inputs new index of every old index, std::numeric_limits<std::size_t>::max() for dropped ones,
+         * empty if no values are combined (e.g. only dropped)
+         */
+        virtual void remap(std::span<std::size_t const> origins, std::span<std::size_t const> inputs) = 0;
+
+        /**
+         * Appends default constructed values or drops values at the end
+         * @param size new number of values
+         */
+        virtual void resize(std::size_t size) = 0;
+
+        AttributeChannel(AttributeChannel &&other) = delete;
+        AttributeChannel(AttributeChannel const &other) = delete;
+        auto operator=(AttributeChannel &&other) -> AttributeChannel & = delete;
+        auto operator=(AttributeChannel const &other) -> AttributeChannel & = delete;
+
+      private:
+        /**
+         * Destroys the channel and returns its memory to the resource it was allocated from
+         */
+        virtual void destroy() = 0;
+
+        std::pmr::string channel_name;
+        std::type_info const *channel_type;
+        Reduction channel_reduction;
+    };
+
+    /**
+     * Values of one channel, stored contiguously (structure of arrays) and indexed by vertex
+     * @tparam T type of the values, reductions other than FIRST require an arithmetic type
+     */
+    template<class T>
+    class TypedAttributeChannel final : public AttributeChannel {
+        static_assert(std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>,
+                      "Attribute values have to be default constructible and copyable");
+
+      public:
+        /**
+         * Constructor, throws std::invalid_argument for a reduction the type does not support
+         * @param name name the channel is registered under
+         * @param values initial values
+         * @param reduction how values of merged vertices are combined
+         * @param resource memory resource for the name and the values
+         */
+        TypedAttributeChannel(std::string_view name, std::span<T const> values, Reduction reduction,
+                              std::pmr::memory_resource *resource) :
+            AttributeChannel(name, typeid(T), reduction, resource),
+            data(values.begin(), values.end(), resource) {
+            if (reduction != Reduction::FIRST && !std::is_arithmetic_v<T>) {
+                throw std::invalid_argument("Only arithmetic attributes can be reduced other than by FIRST");
+            }
+        }
+
+        /**
+         * The values, indexed by vertex
+         * @return values
+         */
+        auto values() -> std::span<T> {
+            return data;
+        }
+
+        void remap(std::span<std::size_t const> origins, std::span<std::size_t const> inputs) override {
+            std::pmr::vector<T> result(origins.size(), data.get_allocator());
+            for (std::size_t i = 0; i < origins.size(); i++) {
+                result[i] = data[origins[i]];
+            }
+
+            if constexpr (std::is_arithmetic_v<T>) {
+                if (reduction() != Reduction::FIRST && !inputs.empty()) {
+                    reduce(origins, inputs, result);
+                }
+            }
+            data = std::move(result);
+        }
+
+        void resize(std::size_t size) override {
+            data.resize(size);
+        }
+
+      private:
+        /**
+         * Input of an old index without a new one, e.g. a point of a removed vertex
+         */
+        static constexpr std::size_t DROPPED = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * Combines the values of all old indices mapped to the same new index
+         */
+        void reduce(std::span<std::size_t const> origins, std::span<std::size_t const> inputs,
+                    std::pmr::vector<T> &result) const {
+            if (reduction() == Reduction::MEAN) {
+                std::pmr::vector<double> sums(origins.size(), 0.0, data.get_allocator());
+                std::pmr::vector<std::size_t> counts(origins.size(), 0, data.get_allocator());
+                for (std::size_t i = 0; i < inputs.size(); i++) {
+                    if (inputs[i] == DROPPED) {
+                        continue;
+                    }
+                    sums[inputs[i]] += static_cast<double>(data[i]);
+                    counts[inputs[i]]++;
+                }
+                for (std::size_t i = 0; i < origins.size(); i++) {
+                    result[i] = static_cast<T>(sums[i] / static_cast<double>(counts[i]));
+                }
+                return;
+            }
+
+            // The origin already initialised the result, fold in the other duplicates
+            for (std::size_t i = 0; i < inputs.size(); i++) {
+                std::size_t const target = inputs[i];
+                if (target == DROPPED || origins[target] == i) {
+                    continue;
+                }
+                switch (reduction()) {
+                    case Reduction::MIN:
+                        result[target] = std::min(result[target], data[i]);
+                        break;
+                    case Reduction::MAX:
+                        result[target] = std::max(result[target], data[i]);
+                        break;
+                    case Reduction::SUM:
+                        result[target] = static_cast<T>(result[target] + data[i]);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        void destroy() override {
+            std::pmr::polymorphic_allocator<> allocator(data.get_allocator().resource());
+            allocator.delete_object(this);
+        }
+
+        std::pmr::vector<T> data;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_ATTRIBUTE_CHANNEL_HPP
@@ -0,0 +1,106 @@
+#ifndef DELAUNAY_BATCH_TRIANGULATION_HPP
+#define DELAUNAY_BATCH_TRIANGULATION_HPP
+
+#include "delaunay/point.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Triangulates many small, independent point sets at once.
+     *
+     * For small sets the cost of a single Delaunay::triangulate call is dominated by setting up
+     * the triangulation. The batch distributes the sets over the thread pool, every worker reusing
+     * one triangulation (and its edge storage) for all sets it processes within the call.
+     * The results of all sets are stored in a few flat arrays, indexed by per set offsets.
+     */
+    class BatchTriangulation {
+      public:
+        /**
+         * Triangulates all point sets
+         * @param point_sets the point sets, not modified
+         * @param resource memory resource for the triangulations of the workers, released before returning
+         * @return results of all sets
+         */
+        static auto triangulate(std::span<std::span<point_t const> const> point_sets,
+                                std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            -> BatchTriangulation;
+
+        /**
+         * Number of triangulated sets
+         * @return number of sets
+         */
+        [[nodiscard]] auto size() const -> std::size_t;
+
+        /**
+         * Vertices of a set (sorted and without duplicates, as in Delaunay::get_vertices)
+         * @param set index of the set
+         * @return vertices of the set
+         */
+        [[nodiscard]] auto get_vertices(std::size_t set) const -> std::span<point_t const>;
+
+        /**
+         * Index of every vertex of a set in the points of that set (as in Delaunay::get_vertex_origins)
+         * @param set index of the set
+         * @return input indices
+         */
+        [[nodiscard]] auto get_vertex_origins(std::size_t set) const -> std::span<std::size_t const>;
+
+        /**
+         * Triangles of a set, as three vertex indices (into get_vertices(set)) per triangle
+         * @param set index of the set
+         * @return vertex indices
+         */
+        [[nodiscard]] auto get_faces(std::size_t set) const -> std::span<std::size_t const>;
+
+        /**
+         * Edges of a set, as two vertex indices (into get_vertices(set)) per edge
+         * @param set index of the set
+         * @return vertex indices
+         */
+        [[nodiscard]] auto get_edges(std::size_t set) const -> std::span<std::size_t const>;
+
+      private:
+        BatchTriangulation() = default;
+
+        /**
+         * Vertices of all sets
+         */
+        std::vector<point_t> vertices;
+
+        /**
+         * Input index of the vertices of all sets
+         */
+        std::vector<std::size_t> vertex_origins;
+
+        /**
+         * Triangles of all sets, three vertex indices each
+         */
+        std::vector<std::size_t> faces;
+
+        /**
+         * Edges of all sets, two vertex indices each
+         */
+        std::vector<std::size_t> edges;
+
+        /**
+         * Start of every set in vertices, one extra entry marking the end
+         */
+        std::vector<std::size_t> vertex_offsets;
+
+        /**
+         * Start of every set in faces, one extra entry marking the end
+         */
+        std::vector<std::size_t> face_offsets;
+
+        /**
+         * Start of every set in edges, one extra entry marking the end
+         */
+        std::vector<std::size_t> edge_offsets;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_BATCH_TRIANGULATION_HPP
@@ -0,0 +1,83 @@
+#ifndef DELAUNAY_CHANGE_SET_HPP
+#define DELAUNAY_CHANGE_SET_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * What changed in a triangulation since the changes were last cleared, see Delaunay::track_changes().
+     *
+     * Edges and faces are given by their vertices, as face ids are renumbered by every change.
+     * An edge is stored with the smaller vertex first, a face counter clockwise starting at its smallest vertex.
+     * All lists are sorted. Churn within an epoch cancels out: a face created and deleted again is in neither list.
+     * All vertex indices but those of removed_edges and removed_faces refer to the current vertex numbering.
+     */
+    struct ChangeSet {
+        explicit ChangeSet(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) :
+            created_edges(resource),
+            deleted_edges(resource),
+            created_faces(resource),
+            deleted_faces(resource),
+            removed_edges(resource),
+            removed_faces(resource),
+            dirty_vertices(resource),
+            renumbered_vertices(resource) {}
+
+        /**
+         * Number of times the changes were cleared
+         */
+        std::uint64_t epoch = 0;
+
+        /**
+         * Edges of triangles that did not exist at the start of the epoch
+         */
+        std::pmr::vector<std::array<std::size_t, 2>> created_edges;
+
+        /**
+         * Edges of triangles that existed at the start of the epoch and are gone
+         */
+        std::pmr::vector<std::array<std::size_t, 2>> deleted_edges;
+
+        /**
+         * Triangles that did not exist at the start of the epoch, three vertex indices each
+         */
+        std::pmr::vector<std::array<std::size_t, 3>> created_faces;
+
+        /**
+         * Triangles that existed at the start of the epoch and are gone, three vertex indices each
+         */
+        std::pmr::vector<std::array<std::size_t, 3>> deleted_faces;
+
+        /**
+         * Edges that existed at the start of the epoch and are gone with a vertex of remove_vertices().
+         * Their vertices have no current index, so they are given in the numbering at the start of the epoch,
+         * the indices of renumbered_vertices.
+         */
+        std::pmr::vector<std::array<std::size_t, 2>> removed_edges;
+
+        /**
+         * Triangles that existed at the start of the epoch and are gone with a vertex of remove_vertices(),
+         * in the numbering at the start of the epoch like removed_edges
+         */
+        std::pmr::vector<std::array<std::size_t, 3>> removed_faces;
+
+        /**
+         * Vertices that moved or gained or lost an edge
+         */
+        std::pmr::vector<std::size_t> dirty_vertices;
+
+        /**
+         * Current index of every vertex, indexed by its index before the first renumbering of the epoch
+         * (rebuilds, optimize_layout() and remove_vertices()). Empty if the vertices were not renumbered.
+         * Removed vertices map to QuadEdge::INVALID_INDEX, the edges and faces deleted with them are in
+         * removed_edges and removed_faces.
+         */
+        std::pmr::vector<std::size_t> renumbered_vertices;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_CHANGE_SET_HPP
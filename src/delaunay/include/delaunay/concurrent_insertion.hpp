@@ -0,0 +1,247 @@
+#ifndef DELAUNAY_CONCURRENT_INSERTION_HPP
+#define DELAUNAY_CONCURRENT_INSERTION_HPP
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/point.hpp"
+#include "delaunay/quad_edge.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Inserts points into a built triangulation from many threads at once.
+     *
+     * Every insert walks to the triangle containing the point without locks, then try-locks the vertices
+     * of its conflict cavity (the triangles whose circumcircle contains the point) one by one. If a vertex is
+     * held by another insert, all locks are released and the insert starts over, so inserts in distant
+     * regions never wait for each other. The cavity is replaced by a fan around the new vertex (Bowyer-Watson).
+     * Only allocating edges is serialised.
+     *
+     * Points outside the convex hull (or on it) are not inserted, the hull of the triangulation does not change.
+     * find_triangle() and get_neighbours() can be called concurrently with the inserts. The getters of the
+     * triangulation are stale (and not thread safe) until finish() appended the new vertices and recomputed
+     * the faces and the vornoi graph.
+     */
+    class ConcurrentInsertion {
+      public:
+        /**
+         * Outcome of an insert
+         */
+        enum class Result : std::uint8_t {
+            /**
+             * The point is a new vertex
+             */
+            INSERTED,
+
+            /**
+             * The point equals an existing vertex
+             */
+            DUPLICATE,
+
+            /**
+             * The point is outside of the convex hull or on it
+             */
+            OUTSIDE_HULL,
+
+            /**
+             * The (inexact) predicates do not give a valid cavity, e.g. for a point extremely close to an edge
+             */
+            DEGENERATE,
+        };
+
+        /**
+         * Starts inserting into the triangulation
+         * @param triangulation built triangulation, must not be used otherwise until finish()
+         * @param capacity maximum number of points inserted
+         */
+        ConcurrentInsertion(Delaunay &triangulation, std::size_t capacity);
+
+        /**
+         * Destructor, calls finish()
+         */
+        ~ConcurrentInsertion();
+
+        /**
+         * Inserts a point, thread safe
+         * @param point point to insert
+         * @return whether the point was inserted, throws std::runtime_error if the capacity is exhausted
+         */
+        auto insert(point_t const &point) -> Result;
+
+        /**
+         * Finds the triangle containing a point, thread safe
+         * @param point point to look up
+         * @return vertex indices of the triangle (counter clockwise), nullopt outside of the hull
+         */
+        auto find_triangle(point_t const &point) -> std::optional<std::array<std::size_t, 3>>;
+
+        /**
+         * Collects the neighbours of a vertex, thread safe
+         * @param vertex vertex index, including inserted vertices
+         * @param neighbours receives the neighbours in counter clockwise order
+         */
+        void get_neighbours(std::size_t vertex, std::vector<std::size_t> &neighbours);
+
+        /**
+         * Number of inserted points so far
+         * @return inserted points
+         */
+        [[nodiscard]] auto size() const -> std::size_t;
+
+        /**
+         * Appends the inserted vertices to the triangulation and recomputes the faces and the vornoi graph.
+         * Must not run concurrently with other calls. Inserted points count as input points after the original ones.
+         */
+        void finish();
+
+        ConcurrentInsertion(ConcurrentInsertion &&other) = delete;
+        ConcurrentInsertion(ConcurrentInsertion const &other) = delete;
+        auto operator=(ConcurrentInsertion &&other) -> ConcurrentInsertion & = delete;
+        auto operator=(ConcurrentInsertion const &other) -> ConcurrentInsertion & = delete;
+
+      private:
+        /**
+         * Outcome of a single attempt, CONFLICT means start over
+         */
+        enum class Attempt : std::uint8_t { DONE, CONFLICT };
+
+        /**
+         * Where the lock free walk ended
+         */
+        struct WalkResult {
+            /**
+             * Edge of the triangle containing the point (on its left), or a hull edge the point is right of
+             */
+            QuadEdge *edge;
+
+            /**
+             * True if the point is right of the hull edge
+             */
+            bool outside;
+        };
+
+        /**
+         * Locks and buffers of one insert, reused between its attempts
+         */
+        struct Cavity {
+            std::vector<std::size_t> locked;
+            std::vector<QuadEdge *> triangles;
+            std::vector<QuadEdge *> boundary;
+            std::vector<QuadEdge *> pending;
+            std::vector<QuadEdge *> spokes;
+        };
+
+        /**
+         * One attempt of insert()
+         */
+        auto try_insert(point_t const &point, Cavity &cavity, Result &result) -> Attempt;
+
+        /**
+         * Walks from a recently inserted vertex towards the point, reading links atomically
+         * @param point target
+         * @return where the walk ended, nullopt if it ran into an edge being changed
+         */
+        auto walk(point_t const &point) -> std::optional<WalkResult>;
+
+        /**
+         * Locks the triangle containing the point and checks it is still there
+         * @param point point
+         * @param cavity receives the locks and the triangle
+         * @param result OUTSIDE_HULL / DUPLICATE if the point is not inside
+         * @return CONFLICT if a lock was held by someone else or the walk was outdated
+         */
+        auto lock_start(point_t const &point, Cavity &cavity, std::optional<Result> &result) -> Attempt;
+
+        /**
+         * Try-locks a vertex, unless this insert holds it already
+         * @return false if another thread holds it
+         */
+        auto try_lock(std::size_t vertex, Cavity &cavity) -> bool;
+
+        /**
+         * Releases all locks of an insert
+         */
+        void unlock(Cavity &cavity);
+
+        /**
+         * Replaces the cavity by a fan around the new vertex
+         */
+        void fill_cavity(point_t const &point, std::size_t vertex, Cavity &cavity);
+
+        /**
+         * Splice of Delaunay, with atomic links for the concurrent walks
+         */
+        static void splice_edges(QuadEdge *a, QuadEdge *b);
+
+        /**
+         * Onext, read atomically
+         */
+        static auto orbit_next(QuadEdge *edge) -> QuadEdge *;
+
+        /**
+         * Oprev, read atomically
+         */
+        static auto orbit_prev(QuadEdge *edge) -> QuadEdge *;
+
+        /**
+         * Lnext, read atomically
+         */
+        static auto left_face_next(QuadEdge *edge) -> QuadEdge *;
+
+        /**
+         * Whether the left face of the edge is a counter clockwise triangle, read atomically
+         */
+        static auto is_triangle(QuadEdge *edge) -> bool;
+
+        Delaunay &triangulation;
+
+        /**
+         * Number of vertices before the first insert
+         */
+        std::size_t base_count;
+
+        /**
+         * Lock word of every vertex, including the reserved ones, 0 if free
+         */
+        std::pmr::vector<std::atomic<std::uint32_t>> vertex_locks;
+
+        /**
+         * One edge leaving every vertex
+         */
+        std::pmr::vector<std::atomic<QuadEdge *>> vertex_edges;
+
+        /**
+         * Positions of the inserted vertices
+         */
+        std::pmr::vector<point_t> inserted;
+
+        /**
+         * Number of inserted vertices
+         */
+        std::atomic<std::size_t> inserted_count{0};
+
+        /**
+         * Start of the next walk
+         */
+        std::atomic<std::size_t> last_vertex{0};
+
+        /**
+         * Guards the edge pool and the edge lists of the triangulation
+         */
+        std::mutex edge_mutex;
+
+        /**
+         * Set by finish()
+         */
+        bool finished = false;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_CONCURRENT_INSERTION_HPP
@@ -0,0 +1,201 @@
+#ifndef DELAUNAY_DECIMATION_HPP
+#define DELAUNAY_DECIMATION_HPP
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/point.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Level of detail decimation of a height field triangulation by vertex removal.
+     *
+     * The heights are a vertex attribute of the triangulation. The error of a vertex is the vertical distance
+     * between its height and the surface of the triangles that would fill its hole, interpolated at its position.
+     * Every step removes an independent set of the vertices with the smallest errors (no two of them neighbours
+     * or sharing one) in one call to Delaunay::detach_vertices(), so the holes are filled in parallel and the
+     * triangulation stays Delaunay. Hull vertices are kept, so the domain does not shrink.
+     * The candidates stay in a priority queue between steps and only the errors of the vertices around the holes
+     * are computed again, so a step takes time in the size of its holes. The removed vertices are dropped from
+     * the triangulation once per level by compact(), which is the only pass over the whole mesh.
+     * The triangulation must not be changed otherwise while it is decimated.
+     */
+    class Decimation {
+      public:
+        /**
+         * One level of detail
+         */
+        struct Level {
+            /**
+             * Remaining vertices
+             */
+            std::vector<point_t> vertices;
+
+            /**
+             * Height of every remaining vertex
+             */
+            std::vector<scalar_t> heights;
+
+            /**
+             * Triangles as three vertex indices per face (counter clockwise)
+             */
+            std::vector<std::size_t> faces;
+
+            /**
+             * Vertex of the triangulation at construction every remaining vertex was
+             */
+            std::vector<std::size_t> origins;
+
+            /**
+             * Largest error of a vertex removed to reach this level
+             */
+            scalar_t max_error = 0;
+        };
+
+        /**
+         * Name of the std::size_t vertex attribute the origins are kept in, so only one decimation per triangulation
+         */
+        static constexpr std::string_view ORIGINS_ATTRIBUTE = "decimation_origins";
+
+        /**
+         * Constructor, throws std::invalid_argument if there is no height attribute or ORIGINS_ATTRIBUTE is taken
+         * @param triangulation triangulation to decimate, must outlive this object
+         * @param height_attribute name of the scalar_t vertex attribute holding the heights
+         */
+        Decimation(Delaunay &triangulation, std::string_view height_attribute);
+
+        /**
+         * Destructor, compacts the triangulation and removes the ORIGINS_ATTRIBUTE channel
+         */
+        ~Decimation();
+
+        Decimation(Decimation &&other) = delete;
+        Decimation(Decimation const &other) = delete;
+        auto operator=(Decimation &&other) -> Decimation & = delete;
+        auto operator=(Decimation const &other) -> Decimation & = delete;
+
+        /**
+         * Removes one independent set of vertices. They stay in the triangulation without edges until compact(),
+         * so the vertex indices do not change between steps.
+         * @param target_vertices number of vertices not to go below
+         * @param error_bound largest error of a removed vertex
+         * @return number of removed vertices, 0 if no vertex can be removed within the bounds
+         */
+        auto step(std::size_t target_vertices, scalar_t error_bound) -> std::size_t;
+
+        /**
+         * Runs steps until the target is reached or no vertex can be removed within the error bound, then compacts
+         * @param target_vertices number of vertices not to go below
+         * @param error_bound largest error of a removed vertex
+         * @return number of vertices left
+         */
+        auto decimate(std::size_t target_vertices, scalar_t error_bound) -> std::size_t;
+
+        /**
+         * Drops the vertices removed by step() from the triangulation, see Delaunay::compact_vertices()
+         */
+        void compact();
+
+        /**
+         * Decimates to every vertex count in turn and takes a copy of each level, finer levels first.
+         * Every level continues from the previous one, so the levels are nested and each removed vertex is
+         * paid for once.
+         * @param vertex_counts targets of the levels, in descending order
+         * @param error_bound largest error of a removed vertex
+         * @return one level per vertex count, with more vertices where the error bound stopped the decimation
+         */
+        auto progressive(std::span<std::size_t const> vertex_counts, scalar_t error_bound) -> std::vector<Level>;
+
+        /**
+         * Vertex of the triangulation at construction every remaining vertex was
+         * @return vertex indices, indexed by current vertex
+         */
+        [[nodiscard]] auto get_origins() const -> std::span<std::size_t const>;
+
+        /**
+         * Largest error of a vertex removed so far
+         * @return error
+         */
+        [[nodiscard]] auto get_max_error() const -> scalar_t;
+
+      private:
+        /**
+         * Finds an edge of every vertex, computes all errors and queues the finite ones.
+         * Steps only recompute the errors around their holes, this is for the start and after flips or rebuilds.
+         */
+        void compute_errors();
+
+        /**
+         * Queues a vertex with its current error, unless it is queued with it already, removed or on the hull
+         * @param origin vertex of the triangulation at construction
+         */
+        void enqueue(std::size_t origin);
+
+        /**
+         * Computes the error of an interior vertex
+         * @param edge any edge leaving the vertex
+         * @param heights heights of all vertices
+         * @param polygon buffer for the vertices of the hole
+         * @param polygon_heights buffer for the heights of the vertices of the hole
+         * @param ring buffer for the triangulation of the hole
+         * @param ears buffer for the triangulation of the hole
+         * @return vertical distance to the triangles filling the hole, infinite for hull vertices
+         */
+        static auto vertex_error(QuadEdge *edge, std::span<scalar_t const> heights, std::pmr::vector<point_t> &polygon,
+                                 std::vector<scalar_t> &polygon_heights, std::pmr::vector<std::size_t> &ring,
+                                 std::pmr::vector<std::array<std::size_t, 3>> &ears) -> scalar_t;
+
+        Delaunay &triangulation;
+
+        /**
+         * Name of the height attribute
+         */
+        std::string height_attribute;
+
+        /**
+         * One edge leaving every vertex, nullptr for removed ones. This and the other vertex arrays are indexed by
+         * the vertex at construction, as these indices stay while the triangulation compacts its vertices.
+         */
+        std::vector<QuadEdge *> vertex_edges;
+
+        /**
+         * Error of every vertex
+         */
+        std::vector<scalar_t> errors;
+
+        /**
+         * Step that last claimed a vertex, indexed by vertex of the triangulation, see step()
+         */
+        std::vector<std::size_t> claims;
+
+        /**
+         * Number of steps so far
+         */
+        std::size_t steps = 0;
+
+        /**
+         * Whether a vertex is in candidates with its current error
+         */
+        std::vector<char> queued;
+
+        /**
+         * Candidates as binary heap of (error, vertex at construction), smallest error first.
+         * Entries with an outdated error are skipped when they come up.
+         */
+        std::vector<std::pair<scalar_t, std::size_t>> candidates;
+
+        /**
+         * See get_max_error()
+         */
+        scalar_t max_error = 0;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_DECIMATION_HPP
@@ -1,11 +1,21 @@
 #ifndef AS_DATA_RECORDER_DELAUNAY_HPP
 #define AS_DATA_RECORDER_DELAUNAY_HPP
 
+#include "delaunay/attribute_channel.hpp"
+#include "delaunay/change_set.hpp"
+#include "delaunay/edge_pool.hpp"
 #include "delaunay/quad_edge.hpp"
-#include "delaunay/gsl.hpp"
 #include "delaunay/point.hpp"
 
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <string_view>
 #include <vector>
 
 namespace delaunay {
@@ -16,42 +26,421 @@ namespace delaunay {
      */
     class Delaunay {
       public:
-        static auto triangulate(std::vector<point_t>& points) -> Delaunay;
+        /**
+         * Triangulates the points, sorting them in place and removing duplicates.
+         * All memory of the triangulation (vertices, edges, faces) is taken from the resource,
+         * which has to outlive the triangulation.
+         * @param points points to triangulate
+         * @param resource memory resource for all allocations of the triangulation
+         * @return the triangulation
+         */
+        static auto triangulate(std::vector<point_t>& points,
+                                std::pmr::memory_resource *resource = std::pmr::get_default_resource()) -> Delaunay;
+
+        /**
+         * Triangulates the points without modifying them.
+         * Only an index permutation is sorted, get_vertex_origins() and get_input_vertices()
+         * map between the vertices of the triangulation and the given points.
+         * @param points points to triangulate, not modified
+         * @param resource memory resource for all allocations of the triangulation
+         * @return the triangulation
+         */
+        static auto triangulate(std::span<point_t const> points,
+                                std::pmr::memory_resource *resource = std::pmr::get_default_resource()) -> Delaunay;
+
+        /**
+         * Loads a triangulation from a snapshot written by save().
+         * The file is memory mapped and the edges are rebuilt from the stored indices
+         * without parsing or allocating single edges.
+         * Throws std::runtime_error if the file can not be read or is not a compatible snapshot.
+         * @param path path of the snapshot file
+         * @param resource memory resource for all allocations of the triangulation
+         * @return the loaded triangulation
+         */
+        static auto load(std::filesystem::path const &path,
+                         std::pmr::memory_resource *resource = std::pmr::get_default_resource()) -> Delaunay;
+
+        /**
+         * Writes the triangulation (vertices, edges as indices, faces and circumcenters)
+         * to a versioned binary snapshot, with every section aligned to a page.
+         * Throws std::runtime_error if the file can not be written.
+         * @param path path of the snapshot file
+         */
+        void save(std::filesystem::path const &path);
 
         /**
-         * Destructor, deletes all edges
+         * Destructor, releases all edges
          */
         ~Delaunay();
 
         /**
          * Get the generated primary edges
          * This is only filled after calling triangulate
-         * @return vector of QuadEdge* (primary edges)
+         * @return view of QuadEdge* (primary edges)
          */
-        auto get_primary_edges() -> std::vector<QuadEdge *> const &;
+        auto get_primary_edges() -> std::span<QuadEdge * const>;
 
         /**
          * Get the generated dual edges
          * This is only filled after calling triangulate
-         * @return vector of QuadEdge* (dual edges)
+         * @return view of QuadEdge* (dual edges)
+         */
+        auto get_dual_edges() -> std::span<QuadEdge * const>;
+
+        /**
+         * Get the vertices of the triangulation (sorted and without duplicates)
+         * The origin_index() of the primary edges indexes into this list
+         * @return view of points
+         */
+        auto get_vertices() -> std::span<point_t const>;
+
+        /**
+         * Get the index of every vertex in the points given to triangulate.
+         * If a point was given multiple times, the first occurrence is the origin of the vertex.
+         * Empty for triangulations loaded from a snapshot.
+         * @return view of input indices, indexed by vertex
+         */
+        auto get_vertex_origins() -> std::span<std::size_t const>;
+
+        /**
+         * Get the vertex every point given to triangulate became.
+         * Duplicates were merged into one vertex, so they map to the same vertex.
+         * Points whose vertex was removed by remove_vertices() map to QuadEdge::INVALID_INDEX.
+         * Empty for triangulations loaded from a snapshot.
+         * @return view of vertex indices, indexed by input index
+         */
+        auto get_input_vertices() -> std::span<std::size_t const>;
+
+        /**
+         * Get the triangles of the triangulation as three vertex indices per face (counter clockwise)
+         * The face id of a triangle is its position in this list divided by three,
+         * see QuadEdge::left_face_index()
+         * @return view of vertex indices
+         */
+        auto get_faces() -> std::span<std::size_t const>;
+
+        /**
+         * Get one primary edge per face, having the face on its left
+         * @return view of QuadEdge*, indexed by face id
+         */
+        auto get_face_edges() -> std::span<QuadEdge * const>;
+
+        /**
+         * Get the circumcenters of all faces (the vornoi vertices)
+         * @return view of points, indexed by face id
+         */
+        auto get_circumcenters() -> std::span<point_t const>;
+
+        /**
+         * Get the area of all faces, computed in parallel on the first call after the faces changed
+         * @return view of areas, indexed by face id
+         */
+        auto get_face_areas() -> std::span<scalar_t const>;
+
+        /**
+         * Registers a channel of one value per vertex, stored contiguously and indexed like get_vertices().
+         * The values are given per input point and go through the same permutation as the points did:
+         * sorted along with them, and combined by the reduction where duplicates were merged into one vertex.
+         * Values of points whose vertex was removed by remove_vertices() are ignored.
+         * The channel follows every later renumbering (optimize_layout(), rebuilds of move_vertices()),
+         * vertices added by ConcurrentInsertion get default constructed values. Channels are not saved in snapshots.
+         * Throws std::invalid_argument if the name is taken, the number of values is wrong or
+         * the reduction needs an arithmetic type.
+         * @tparam T type of the values
+         * @param name name of the channel
+         * @param values one value per input point, or per vertex for triangulations loaded from a snapshot
+         * @param reduction how values of duplicates are combined
+         * @return values of the channel, indexed by vertex
+         */
+        template<class T>
+        auto add_vertex_attribute(std::string_view name, std::span<T const> values,
+                                  Reduction reduction = Reduction::FIRST) -> std::span<T>;
+
+        /**
+         * Get the values of a channel registered with add_vertex_attribute().
+         * Throws std::invalid_argument if there is no channel of that name and type.
+         * @tparam T type of the values
+         * @param name name of the channel
+         * @return values of the channel, indexed by vertex
+         */
+        template<class T>
+        auto get_vertex_attribute(std::string_view name) -> std::span<T>;
+
+        /**
+         * Removes a channel, nothing happens if there is no channel of that name
+         * @param name name of the channel
+         */
+        void remove_vertex_attribute(std::string_view name);
+
+        /**
+         * Get the edges of the convex hull in O(h), walking along the outer face
+         * starting at the hull edge retained from the divide and conquer algorithm
+         * @return hull edges in counter clockwise order, with the triangulation on their left
+         */
+        auto get_convex_hull() -> std::vector<QuadEdge *>;
+
+        /**
+         * Renumbers the vertices along a hilbert curve and stores the edges in the order of their vertices,
+         * so walks over the mesh access memory nearly sequentially.
+         * Deleted edges are dropped, vertex, edge and face indices change, previous QuadEdge* become invalid.
+         */
+        void optimize_layout();
+
+        /**
+         * Moves the vertices and restores the Delaunay property with local edge flips, which is close to O(n)
+         * for small movements. Vertices crossing the hull become hull vertices and hull vertices that moved
+         * inwards are enclosed by new triangles. If a triangle is inverted otherwise, the triangulation is rebuilt,
+         * in which case vertex indices change and merged duplicates are removed.
+         * Face ids change either way, previous QuadEdge* stay valid unless rebuilt.
+         * Throws std::invalid_argument if the number of positions does not match the number of vertices.
+         * @param positions new position of every vertex, indexed like get_vertices()
+         * @return true if repaired by flips, false if rebuilt
+         */
+        auto move_vertices(std::span<point_t const> positions) -> bool;
+
+        /**
+         * Removes interior vertices and fills every hole with triangles of its ring, clipped as Delaunay ears,
+         * so only the triangles around the removed vertices change. The holes are filled in parallel,
+         * which requires them to be independent: no two removed vertices may be neighbours or share one.
+         * The remaining vertices keep their order and are numbered without gaps, removed input points map to
+         * QuadEdge::INVALID_INDEX in get_input_vertices(), the vertex attributes follow. Face and edge ids change,
+         * previous QuadEdge* stay valid except for the edges of the removed vertices.
+         * This is detach_vertices() followed by compact_vertices(), so it takes time in the size of the mesh.
+         * Throws std::invalid_argument for invalid or duplicate indices, hull vertices and dependent vertices.
+         * @param removed indices of the vertices to remove
+         * @return true if only the triangles around the removed vertices changed, false after flips or a rebuild
          */
-        auto get_dual_edges() -> std::vector<QuadEdge *> const &;
+        auto remove_vertices(std::span<std::size_t const> removed) -> bool;
+
+        /**
+         * Removes interior vertices like remove_vertices(), in time proportional to the holes instead of the mesh.
+         * The removed vertices stay in get_vertices() without edges until compact_vertices(), so the indices of all
+         * vertices stay and repeated removals do not renumber anything. Only the faces and circumcenters of the
+         * holes are computed, the new faces take the ids of the old ones and the last faces move to the ids left
+         * over. Ears the inexact predicates misplaced are repaired by flips, and if these cycle the vertices are
+         * compacted and triangulated again like in move_vertices(), which renumbers them and invalidates all
+         * QuadEdge*. Compact before any other change of the triangulation.
+         * Throws std::invalid_argument for deleted edges, hull vertices and dependent or duplicate vertices.
+         * @param leaving one edge leaving every vertex to remove
+         * @return true if only the triangles around the removed vertices changed, false after flips or a rebuild
+         */
+        auto detach_vertices(std::span<QuadEdge *const> leaving) -> bool;
+
+        /**
+         * Drops the vertices removed by detach_vertices() and the deleted edges. The remaining vertices keep their
+         * order and are numbered without gaps, the input vertices, vertex attributes and recorded changes follow.
+         */
+        void compact_vertices();
+
+        /**
+         * Get the vertices removed by detach_vertices() that are not compacted yet
+         * @return view of vertex indices, in the order they were removed
+         */
+        auto get_detached_vertices() -> std::span<std::size_t const>;
+
+        /**
+         * Starts or stops recording what move_vertices(), optimize_layout(), remove_vertices() and
+         * ConcurrentInsertion change, see get_changes(). Off by default, as every recorded change scans the faces
+         * once more.
+         * @param enabled whether changes are recorded
+         */
+        void track_changes(bool enabled);
+
+        /**
+         * Get the changes recorded since the last clear_changes()
+         * @return created and deleted edges and faces and the dirty vertices of this epoch
+         */
+        auto get_changes() -> ChangeSet const &;
+
+        /**
+         * Empties the change set and starts a new epoch
+         * @return the new epoch
+         */
+        auto clear_changes() -> std::uint64_t;
 
       private:
+        /**
+         * Constructor, creates an empty triangulation to be filled by build()
+         * @param resource memory resource for all allocations
+         */
+        explicit Delaunay(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
         /**
         * Constructor, runs algorithm
         */
-        explicit Delaunay(std::vector<point_t>& points);
+        Delaunay(std::vector<point_t>& points, std::pmr::memory_resource *resource);
+
+        /**
+         * Constructor, runs algorithm without modifying the points
+         */
+        Delaunay(std::span<point_t const> points, std::pmr::memory_resource *resource);
+
+        /**
+         * Constructor, loads a snapshot
+         * @param snapshot_path path of the snapshot file
+         * @param resource memory resource for all allocations
+         */
+        Delaunay(std::filesystem::path const &snapshot_path, std::pmr::memory_resource *resource);
+
+        /**
+         * Memory resource all allocations of the triangulation are taken from
+         * @return the memory resource
+         */
+        [[nodiscard]] auto memory_resource() const -> std::pmr::memory_resource *;
+
+        /**
+         * Sets the vertices to the points in the order required by the divide and conquer algorithm,
+         * without duplicates, and fills vertex_origins / input_vertices
+         * @param points points to triangulate
+         */
+        void set_vertices(std::span<point_t const> points);
+
+        /**
+         * Triangulates the (sorted, duplicate free) vertices and creates the vornoi graph
+         */
+        void build();
+
+        /**
+         * Removes all vertices and edges, keeping the allocated memory for the next build().
+         * Vertex attribute channels are kept, so rebuild() can remap them.
+         */
+        void clear();
+
+        /**
+         * Rebuilds the triangulation from the current vertices, which are sorted again.
+         * vertex_origins / input_vertices and the vertex attributes are updated to the new vertex order.
+         */
+        void rebuild();
+
+        /**
+         * Checks that all triangles are still counter clockwise after the vertices moved.
+         * A triangle inverted by an interior vertex crossing a hull edge is removed with that hull edge.
+         * @return false if another triangle is inverted
+         */
+        auto release_inverted_faces() -> bool;
+
+        /**
+         * Closes pockets of hull vertices that moved inwards with new triangles, until the hull is convex again
+         * @return false if a pocket could not be closed locally
+         */
+        auto make_hull_convex() -> bool;
+
+        /**
+         * Flips edges that are not locally Delaunay until none is left (Lawson flips)
+         * @return false if the flips did not terminate within their budget
+         */
+        auto restore_delaunay() -> bool;
+
+        /**
+         * Replaces the edge by the other diagonal of the quadrilateral formed by its two triangles
+         * @param edge edge to flip, with a triangle on both sides
+         */
+        void flip_edge(QuadEdge *edge);
+
+        /**
+         * Numbers the faces again and recomputes the vornoi graph, after the edges changed
+         */
+        void update_vornoi_graph();
+
+        /**
+         * Deletes the edges of a vertex and triangulates the hole with the deleted edges
+         * @param edge any edge leaving the vertex
+         * @param new_faces receives one edge of every new triangle with the triangle on its left,
+         *                  one slot per triangle around the vertex, of which the last two stay unused
+         * @param spokes buffer for the edges of the vertex
+         * @param outgoing buffer for the edges around the hole, each leaving its vertex of the hole
+         * @param polygon buffer for the vertices of the hole
+         * @param ring buffer for triangulate_hole()
+         * @param ears buffer for triangulate_hole()
+         * @return false if an ear was not Delaunay and the hole has to be repaired by flips
+         */
+        static auto remove_vertex(QuadEdge *edge, std::span<QuadEdge *> new_faces,
+                                  std::pmr::vector<QuadEdge *> &spokes, std::pmr::vector<QuadEdge *> &outgoing,
+                                  std::pmr::vector<point_t> &polygon, std::pmr::vector<std::size_t> &ring,
+                                  std::pmr::vector<std::array<std::size_t, 3>> &ears) -> bool;
+
+        /**
+         * Numbers the triangles of filled holes with the ids of the ones they replace and computes only their
+         * circumcenters, instead of the whole vornoi graph. The ids left over are filled with the last faces.
+         * @param old_faces ids of the triangles around the removed vertices, hole by hole
+         * @param offsets start of every hole in old_faces, followed by the size of old_faces
+         * @param new_faces edges of the new triangles, at the positions of old_faces, see remove_vertex()
+         */
+        void replace_faces(std::span<std::size_t const> old_faces, std::span<std::size_t const> offsets,
+                           std::span<QuadEdge *const> new_faces);
+
+        /**
+         * Numbers a triangle and sets its vertices, circumcenter and dual edges
+         * @param face id of the triangle
+         * @param edge an edge with the triangle on its left
+         */
+        void set_face(std::size_t face, QuadEdge *edge);
 
         /**
-         * The recursive delaunay algorithm
-         * @param points List of points to triangulate
-         * @param start Offset in points list
-         * @param length Length in poitns list
+         * Reuses a deleted edge to connect the destination of a to the origin of b, like connect_edges()
+         * @param edge deleted edge
+         * @param a first edge
+         * @param b second edge
+         */
+        static void reconnect_edge(QuadEdge *edge, QuadEdge *a, QuadEdge *b);
+
+        /**
+         * Looks up a vertex attribute channel
+         * @param name name of the channel
+         * @return the channel, nullptr if there is none
+         */
+        auto find_vertex_attribute(std::string_view name) -> AttributeChannel *;
+
+        /**
+         * Renumbers all vertex attribute channels along with the vertices
+         * @param origins first previous vertex of every new vertex
+         * @param inputs new vertex of every previous vertex
+         */
+        void remap_vertex_attributes(std::span<std::size_t const> origins, std::span<std::size_t const> inputs);
+
+        /**
+         * Marks a vertex whose edges are about to change, if changes are tracked
+         * @param vertex vertex index
+         */
+        void touch_vertex(std::size_t vertex);
+
+        /**
+         * Compares the faces around the touched vertices with previous_faces and adds the difference to the changes
+         * @param renumbering new index of every previous vertex, empty if the vertices kept their index
+         * @param everything compare all faces instead of those around the touched vertices
+         */
+        void record_changes(std::span<std::size_t const> renumbering, bool everything);
+
+        /**
+         * Maps the recorded changes to new vertex indices
+         * @param renumbering new index of every previous vertex
+         */
+        void renumber_changes(std::span<std::size_t const> renumbering);
+
+        /**
+         * Whether the build was cancelled through cancel_flag
+         * @return true if the build should stop
+         */
+        [[nodiscard]] auto is_cancelled() const -> bool;
+
+        /**
+         * The divide and conquer algorithm, bottom up without recursion.
+         * All leaves (triangles and single edges) are built in one sweep over the points, then neighbouring
+         * hulls are merged level by level, first within tiles of leaves and then across the tiles.
+         * @param points List of points to triangulate, sorted and without duplicates
          * @return Left(=second) and Right(=first) most Edge
          */
-        auto delaunay_divide_and_conquer(std::vector<point_t> const &points, std::size_t start, std::size_t length)
-            -> std::pair<QuadEdge *, QuadEdge *>;
+        auto delaunay_divide_and_conquer(std::pmr::vector<point_t> const &points) -> std::pair<QuadEdge *, QuadEdge *>;
+
+        /**
+         * Merges neighbouring hulls pairwise, level by level, until one is left. Stops between levels once cancelled.
+         * @param hulls Left(=second) and Right(=first) most Edge of every hull, ordered like the points
+         * @param first first hull to merge
+         * @param last end of the hulls to merge
+         * @return Left(=second) and Right(=first) most Edge of the merged hull
+         */
+        auto merge_levels(std::pmr::vector<std::pair<QuadEdge *, QuadEdge *>> &hulls, std::size_t first,
+                          std::size_t last) -> std::pair<QuadEdge *, QuadEdge *>;
 
         /**
          * Build a triangle out of 3 points
@@ -59,7 +448,8 @@ namespace delaunay {
          * @param points array of points
          * @return Left(=second) and Right(=first) most Edge
          */
-        auto build_triangle(std::size_t start, std::vector<point_t> const &points) -> std::pair<QuadEdge *, QuadEdge *>;
+        auto build_triangle(std::size_t start, std::pmr::vector<point_t> const &points)
+            -> std::pair<QuadEdge *, QuadEdge *>;
 
         /**
          * Merge the halves of the delaunay graph from divide and conquer
@@ -81,18 +471,37 @@ namespace delaunay {
 
         /**
          * Creates the dual edges of the graph (vornoi diagram)
-         * starting the build at the right most edge
-         * @param start The edge to start the build from  (should be the right most edge)
+         * First every triangle gets a face id in one linear sweep over the edges,
+         * then all circumcenters are computed in parallel into a flat array,
+         * from which the dual edges are filled in parallel.
          */
-        static void calculate_vornoi_graph(QuadEdge *start);
+        void calculate_vornoi_graph();
+
+        /**
+         * Assigns an id to every counter clockwise triangle, stored as origin index of the dual edges
+         * pointing out of the face and fills faces / face_edges
+         * @param edges primary edges to sweep over (either direction)
+         */
+        void assign_face_ids(std::pmr::vector<QuadEdge *> const &edges);
 
         /**
          * Create a new edge, and its QuadEdge entries
-         * @param origin the start point of the edge
-         * @param destination the end point of the edge
+         * @param origin index of the start point of the edge
+         * @param destination index of the end point of the edge
          * @return QuadEdge* to the new edge
          */
-        auto make_edge(point_t const &origin, point_t const &destination) -> QuadEdge *;
+        auto make_edge(std::size_t origin, std::size_t destination) -> QuadEdge *;
+
+        /**
+         * Create a new edge to a point that is not in the vertex list yet
+         * @param origin start point of the edge
+         * @param origin_index index of the start point
+         * @param destination end point of the edge
+         * @param destination_index index of the end point
+         * @return QuadEdge* to the new edge
+         */
+        auto make_edge(point_t const &origin, std::size_t origin_index, point_t const &destination,
+                       std::size_t destination_index) -> QuadEdge *;
 
         /**
          * Deletes an edge out a ring
@@ -131,24 +540,113 @@ namespace delaunay {
         auto connect_edges(QuadEdge *a, QuadEdge *b) -> QuadEdge *;
 
         /**
-         * Vector to hold all pointers to ensure memory safety (all primary edges)
+         * All points of the triangulation, sorted and without duplicates
+         */
+        std::pmr::vector<point_t> vertices;
+
+        /**
+         * Input index of every vertex
          */
-        std::vector<gsl::owner<QuadEdge *>> primary_edges;
+        std::pmr::vector<std::size_t> vertex_origins;
 
         /**
-         * Vector to hold all pointers to ensure memory safety (all sym primary edges)
+         * Vertex index of every input point
          */
-        std::vector<gsl::owner<QuadEdge *>> primary_sym_edges;
+        std::pmr::vector<std::size_t> input_vertices;
 
         /**
-         * Vector to hold all pointers to ensure memory safety (all dual edges)
+         * Vertices removed by detach_vertices(), kept without edges until compact_vertices()
          */
-        std::vector<gsl::owner<QuadEdge *>> dual_edges;
+        std::pmr::vector<std::size_t> detached_vertices;
 
         /**
-         * Vector to hold all pointers to ensure memory safety (all sym dual edges)
+         * Edge on the convex hull, as returned by the divide and conquer algorithm
          */
-        std::vector<gsl::owner<QuadEdge *>> dual_sym_edges;
+        QuadEdge *hull_edge;
+
+        /**
+         * Three vertex indices per triangle, indexed by face id
+         */
+        std::pmr::vector<std::size_t> faces;
+
+        /**
+         * One edge per triangle having the triangle on its left, indexed by face id
+         */
+        std::pmr::vector<QuadEdge *> face_edges;
+
+        /**
+         * Circumcenter of each triangle, indexed by face id
+         */
+        std::pmr::vector<point_t> circumcenters;
+
+        /**
+         * Area of each triangle, indexed by face id, empty until requested after the faces changed
+         */
+        std::pmr::vector<scalar_t> face_areas;
+
+        /**
+         * Channels registered with add_vertex_attribute()
+         */
+        std::pmr::vector<std::unique_ptr<AttributeChannel, AttributeChannel::Deleter>> vertex_attributes;
+
+        /**
+         * Storage of all QuadEdges
+         */
+        EdgePool edge_pool;
+
+        /**
+         * Vector to hold all pointers (all primary edges)
+         */
+        std::pmr::vector<QuadEdge *> primary_edges;
+
+        /**
+         * Vector to hold all pointers (all sym primary edges)
+         */
+        std::pmr::vector<QuadEdge *> primary_sym_edges;
+
+        /**
+         * Vector to hold all pointers (all dual edges)
+         */
+        std::pmr::vector<QuadEdge *> dual_edges;
+
+        /**
+         * Vector to hold all pointers (all sym dual edges)
+         */
+        std::pmr::vector<QuadEdge *> dual_sym_edges;
+
+        /**
+         * Whether changes are recorded, see track_changes()
+         */
+        bool changes_tracked = false;
+
+        /**
+         * Changes of the current epoch
+         */
+        ChangeSet changes;
+
+        /**
+         * Faces before the change being recorded
+         */
+        std::pmr::vector<std::size_t> previous_faces;
+
+        /**
+         * Vertices whose edges changed since the last recorded change
+         */
+        std::pmr::vector<std::size_t> touched_vertices;
+
+        /**
+         * Vertices that moved since the last recorded change
+         */
+        std::pmr::vector<std::size_t> moved_vertices;
+
+        /**
+         * Set while building in the background, build() stops between its stages once the flag is set
+         */
+        std::atomic<bool> const *cancel_flag = nullptr;
+
+        friend class BatchTriangulation;
+        friend class AsyncTriangulation;
+        friend class ConcurrentInsertion;
 
       public:
         /**
@@ -176,6 +674,38 @@ namespace delaunay {
         auto operator=(Delaunay &&other) -> Delaunay & = delete;
     };
 
+    template<class T>
+    auto Delaunay::add_vertex_attribute(std::string_view name, std::span<T const> values, Reduction reduction)
+        -> std::span<T> {
+        if (find_vertex_attribute(name) != nullptr) {
+            throw std::invalid_argument("A vertex attribute of that name exists already");
+        }
+
+        // Snapshots have no input mapping, their values are given per vertex
+        std::size_t const expected = input_vertices.empty() ? vertices.size() : input_vertices.size();
+        if (values.size() != expected) {
+            throw std::invalid_argument("Expected one attribute value per input point");
+        }
+
+        std::pmr::polymorphic_allocator<> allocator(memory_resource());
+        auto *channel = allocator.new_object<TypedAttributeChannel<T>>(name, values, reduction, memory_resource());
+        std::unique_ptr<AttributeChannel, AttributeChannel::Deleter> owner(channel);
+        vertex_attributes.push_back(std::move(owner));
+        if (!input_vertices.empty()) {
+            channel->remap(vertex_origins, input_vertices);
+        }
+        return channel->values();
+    }
+
+    template<class T>
+    auto Delaunay::get_vertex_attribute(std::string_view name) -> std::span<T> {
+        AttributeChannel *channel = find_vertex_attribute(name);
+        if (channel == nullptr || channel->type() != typeid(T)) {
+            throw std::invalid_argument("No vertex attribute of that name and type");
+        }
+        return static_cast<TypedAttributeChannel<T> *>(channel)->values();
+    }
+
 }// namespace analyser
 
 #endif// AS_DATA_RECORDER_DELAUNAY_HPP
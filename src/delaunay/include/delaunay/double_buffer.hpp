@@ -0,0 +1,74 @@
+#ifndef DELAUNAY_DOUBLE_BUFFER_HPP
+#define DELAUNAY_DOUBLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace delaunay {
+    /**
+     * Holds the latest published value of a single writer, readable from any thread without locks.
+     *
+     * The writer fills the slot that is not visible to readers, then flips the front index.
+     * Readers announce themselves on the slot they read, so the writer never overwrites a slot
+     * that is still being copied. A reader that raced with a flip simply retries.
+     *
+     * @tparam T type of the published values
+     */
+    template<class T>
+    class DoubleBuffer {
+      public:
+        /**
+         * Latest published value
+         * @return shared pointer to the value, nullptr if nothing was published yet
+         */
+        [[nodiscard]] auto read() const -> std::shared_ptr<T> {
+            while (true) {
+                std::size_t const slot = front.load();
+                readers[slot]++;
+                if (front.load() == slot) {
+                    std::shared_ptr<T> value = slots[slot];
+                    readers[slot]--;
+                    return value;
+                }
+                readers[slot]--;
+            }
+        }
+
+        /**
+         * Publishes a new value, only to be called by one thread at a time
+         * @param value value to publish
+         */
+        void publish(std::shared_ptr<T> value) {
+            std::size_t const back = 1 - front.load();
+
+            // Readers still copying an old value out of the back slot finish within a few instructions
+            while (readers[back].load() != 0) {
+                std::this_thread::yield();
+            }
+
+            slots[back] = std::move(value);
+            front.store(back);
+        }
+
+      private:
+        /**
+         * Front and back value
+         */
+        std::array<std::shared_ptr<T>, 2> slots;
+
+        /**
+         * Slot readers take the value from
+         */
+        std::atomic<std::size_t> front{0};
+
+        /**
+         * Number of readers currently copying each slot
+         */
+        mutable std::array<std::atomic<std::size_t>, 2> readers{};
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_DOUBLE_BUFFER_HPP
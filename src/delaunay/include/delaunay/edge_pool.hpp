@@ -0,0 +1,72 @@
+#ifndef DELAUNAY_EDGE_POOL_HPP
+#define DELAUNAY_EDGE_POOL_HPP
+
+#include "delaunay/quad_edge.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Block storage for the QuadEdges of a triangulation.
+     *
+     * The four quarter edges of an edge are stored next to each other, in rot order.
+     * Blocks are never reallocated, so pointers stay valid until the pool is cleared.
+     * Clearing keeps the blocks, so a triangulation that is rebuilt does not allocate again.
+     * All blocks are taken from the memory resource of the pool.
+     */
+    class EdgePool {
+      public:
+        /**
+         * Constructor
+         * @param resource memory resource the blocks are allocated from
+         */
+        explicit EdgePool(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+        /**
+         * Number of edges (of four quarter edges each) per block
+         */
+        static constexpr std::size_t EDGES_PER_BLOCK = 1024;
+
+        /**
+         * Constructs the four quarter edges of a new edge
+         * @param origin origin point of the primary edge
+         * @param origin_index index of the origin point
+         * @param destination destination point of the primary edge
+         * @param destination_index index of the destination point
+         * @return pointer to the first of the four quarter edges (the primary edge)
+         */
+        auto allocate(point_t const &origin, std::size_t origin_index, point_t const &destination,
+                      std::size_t destination_index) -> QuadEdge *;
+
+        /**
+         * Destroys all edges, keeping the memory for reuse
+         */
+        void clear();
+
+        /**
+         * Number of edges allocated since the last clear
+         * @return number of edges
+         */
+        [[nodiscard]] auto size() const -> std::size_t;
+
+      private:
+        /**
+         * Blocks of quarter edges, each reserved to 4 * EDGES_PER_BLOCK elements
+         */
+        std::pmr::vector<std::pmr::vector<QuadEdge>> blocks;
+
+        /**
+         * Block new edges are taken from
+         */
+        std::size_t active_block = 0;
+
+        /**
+         * Number of edges allocated since the last clear
+         */
+        std::size_t edge_count = 0;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_EDGE_POOL_HPP
@@ -0,0 +1,112 @@
+#ifndef DELAUNAY_LLOYD_RELAXATION_HPP
+#define DELAUNAY_LLOYD_RELAXATION_HPP
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/point.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Lloyd relaxation (centroidal vornoi iterations) on an existing triangulation.
+     *
+     * Every iteration clips the vornoi cell of each vertex to a rectangle, moves the vertex to the centroid
+     * of its cell and repairs the triangulation with local flips (Delaunay::move_vertices), so an iteration
+     * costs close to O(n) instead of a full rebuild. Moves that would invert a triangle are shortened.
+     * The centroids are computed in parallel from the dual.
+     */
+    class LloydRelaxation {
+      public:
+        /**
+         * Relaxes within the bounding box of the current vertices
+         * @param triangulation triangulation to relax, must outlive this object
+         */
+        explicit LloydRelaxation(Delaunay &triangulation);
+
+        /**
+         * Relaxes within the given rectangle
+         * @param triangulation triangulation to relax, must outlive this object
+         * @param min lower left corner of the rectangle the cells are clipped to
+         * @param max upper right corner of the rectangle the cells are clipped to
+         */
+        LloydRelaxation(Delaunay &triangulation, point_t const &min, point_t const &max);
+
+        /**
+         * Runs iterations until no vertex moves further than the tolerance or the iteration cap is reached
+         * @param max_iterations iteration cap
+         * @param tolerance largest movement of a vertex at which the relaxation counts as converged
+         * @return number of iterations run
+         */
+        auto relax(std::size_t max_iterations, scalar_t tolerance) -> std::size_t;
+
+        /**
+         * Runs a single iteration
+         * @return largest movement of a vertex
+         */
+        auto step() -> scalar_t;
+
+        /**
+         * Number of iterations, in which the triangulation could not be repaired by flips and was rebuilt
+         * @return number of rebuilds
+         */
+        [[nodiscard]] auto get_rebuild_count() const -> std::size_t;
+
+      private:
+        /**
+         * Number of times a move is halved before the vertex stays in place for this iteration
+         */
+        static constexpr std::uint8_t MAX_HALVINGS = 4;
+
+        /**
+         * Computes the centroid of the clipped vornoi cell of every vertex
+         */
+        void compute_centroids();
+
+        /**
+         * Shortens the moves that would invert a triangle, so the triangulation can be repaired locally.
+         * Shortened vertices continue in the next iteration.
+         */
+        void limit_moves();
+
+        /**
+         * Computes the centroid of the clipped vornoi cell of a vertex
+         * @param edge any edge leaving the vertex
+         * @param cell buffer for the cell polygon
+         * @param clipped buffer for the clipped polygon
+         * @return centroid, the vertex itself if the clipped cell is empty
+         */
+        auto cell_centroid(QuadEdge *edge, std::vector<point_t> &cell, std::vector<point_t> &clipped) const
+            -> point_t;
+
+        Delaunay &triangulation;
+
+        /**
+         * Lower left corner of the clipping rectangle
+         */
+        point_t min;
+
+        /**
+         * Upper right corner of the clipping rectangle
+         */
+        point_t max;
+
+        /**
+         * One edge leaving every vertex
+         */
+        std::vector<QuadEdge *> vertex_edges;
+
+        /**
+         * New position of every vertex
+         */
+        std::vector<point_t> centroids;
+
+        /**
+         * Number of rebuilds, see get_rebuild_count()
+         */
+        std::size_t rebuild_count = 0;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_LLOYD_RELAXATION_HPP
@@ -0,0 +1,197 @@
+#ifndef DELAUNAY_PATH_SEARCH_HPP
+#define DELAUNAY_PATH_SEARCH_HPP
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/quad_edge.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Describes in which set of the search a node is, comparable to the EdgeState of an edge
+     */
+    enum class SearchState : std::uint8_t {
+        /**
+         * Node was not reached yet
+         */
+        UNVISITED = 0,
+
+        /**
+         * Node was reached and is waiting to be expanded (open set)
+         */
+        OPEN = 1,
+
+        /**
+         * Node was expanded, its cost is final (closed set)
+         */
+        CLOSED = 2,
+    };
+
+    /**
+     * A* / Dijkstra shortest path search running directly on the QuadEdge graph of a triangulation.
+     *
+     * The search either moves between the triangles of the mesh (FACES), or between the midpoints of its edges
+     * (EDGE_MIDPOINTS). Every node is identified by one of its primary half edges, so the open and closed sets
+     * are per half edge marks stored in flat buffers. These buffers are kept between queries and reset in O(1) using
+     * an epoch counter, so repeated queries on the same triangulation do not allocate.
+     */
+    class PathSearch {
+      public:
+        /**
+         * Graph the search is running on
+         */
+        enum class Graph : std::uint8_t {
+            /**
+             * Nodes are the triangles, the position of a node is the centroid of the triangle.
+             * Moving between two triangles crosses their shared edge.
+             */
+            FACES = 0,
+
+            /**
+             * Nodes are the edges, the position of a node is the midpoint of the edge.
+             * Moving between two edges passes through the triangle they share.
+             */
+            EDGE_MIDPOINTS = 1,
+        };
+
+        /**
+         * Additional cost of crossing (FACES) or entering (EDGE_MIDPOINTS) an edge.
+         * The cost is added to the euclidean distance between the nodes and must not be negative,
+         * an infinite cost blocks the edge.
+         */
+        using cost_function_t = std::function<scalar_t(QuadEdge *)>;
+
+        /**
+         * Constructor, sizes the buffers for the given triangulation
+         * @param triangulation triangulation to search on, must outlive this object
+         */
+        explicit PathSearch(Delaunay &triangulation);
+
+        /**
+         * Searches the cheapest path between two nodes
+         *
+         * For FACES the start and goal node is the triangle to the left of the given edge,
+         * for EDGE_MIDPOINTS it is the given edge itself.
+         *
+         * @param start edge identifying the start node
+         * @param goal edge identifying the goal node
+         * @param graph graph to search on
+         * @param edge_cost additional cost per edge, may be empty
+         * @param use_heuristic true for A* (euclidean distance to the goal), false for Dijkstra
+         * @return true if a path was found
+         */
+        auto find_path(QuadEdge *start, QuadEdge *goal, Graph graph, cost_function_t const &edge_cost = nullptr,
+                       bool use_heuristic = true) -> bool;
+
+        /**
+         * The path found by the last successful call to find_path
+         *
+         * For FACES the left face of each edge is the triangle visited at that step, so every edge but the first
+         * is an edge crossed by the path. For EDGE_MIDPOINTS every edge is a visited midpoint.
+         * The first entry is the start node, the last entry the goal node.
+         * @return path from start to goal, the buffer is reused by the next query
+         */
+        auto get_path() -> std::vector<QuadEdge *> const &;
+
+        /**
+         * The cost of the path found by the last successful call to find_path
+         * @return cost of the path
+         */
+        [[nodiscard]] auto get_cost() const -> scalar_t;
+
+        /**
+         * The number of nodes expanded by the last call to find_path
+         * @return size of the closed set
+         */
+        [[nodiscard]] auto get_expanded_nodes() const -> std::size_t;
+
+      private:
+        /**
+         * Prepares the buffers for a new query
+         */
+        void reset();
+
+        /**
+         * Index of the node identified by the edge, into the per node buffers
+         * @param edge edge identifying the node
+         * @param graph graph of the query
+         * @return node index
+         */
+        static auto node_index(QuadEdge *edge, Graph graph) -> std::size_t;
+
+        /**
+         * Position of the node identified by the edge
+         * @param edge edge identifying the node
+         * @param graph graph of the query
+         * @return centroid of the face or midpoint of the edge
+         */
+        static auto node_position(QuadEdge *edge, Graph graph) -> point_t;
+
+        /**
+         * Returns the state of the node in the current query
+         * @param node node index
+         * @return state of the node
+         */
+        auto state(std::size_t node) -> SearchState;
+
+        /**
+         * Triangulation the search is running on
+         */
+        Delaunay &triangulation;
+
+        /**
+         * Current query, marks of older queries are treated as UNVISITED
+         */
+        std::uint32_t epoch;
+
+        /**
+         * Query in which the node was last touched, one entry per primary half edge
+         */
+        std::vector<std::uint32_t> node_epochs;
+
+        /**
+         * State of each node, only valid if node_epochs matches the current epoch
+         */
+        std::vector<SearchState> node_states;
+
+        /**
+         * Best known cost from the start to each node
+         */
+        std::vector<scalar_t> node_costs;
+
+        /**
+         * Edge identifying each node, as it was reached (for FACES the entered face is on its left)
+         */
+        std::vector<QuadEdge *> node_edges;
+
+        /**
+         * Node each node was reached from
+         */
+        std::vector<std::size_t> node_parents;
+
+        /**
+         * Open set as binary heap of (estimated total cost, node)
+         */
+        std::vector<std::pair<scalar_t, std::size_t>> open_set;
+
+        /**
+         * Result of the last query
+         */
+        std::vector<QuadEdge *> path;
+
+        /**
+         * Cost of the last path
+         */
+        scalar_t path_cost;
+
+        /**
+         * Number of nodes expanded in the last query
+         */
+        std::size_t expanded_nodes;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_PATH_SEARCH_HPP
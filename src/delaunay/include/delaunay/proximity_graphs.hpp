@@ -0,0 +1,58 @@
+#ifndef DELAUNAY_PROXIMITY_GRAPHS_HPP
+#define DELAUNAY_PROXIMITY_GRAPHS_HPP
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/quad_edge.hpp"
+
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Derives proximity graphs from a finished triangulation.
+     *
+     * The Delaunay triangulation contains the euclidean minimum spanning tree (EMST),
+     * the relative neighbourhood graph (RNG) and the gabriel graph (GG):
+     * EMST ⊆ RNG ⊆ GG ⊆ DT
+     * Therefore only the live primary edges of the triangulation have to be considered as candidates,
+     * which is O(n) edges instead of O(n²) point pairs.
+     */
+    class ProximityGraphs {
+      public:
+        /**
+         * Computes the euclidean minimum spanning tree using Kruskal's algorithm
+         * (parallel sort of the edges by length and union-find on the vertex indices).
+         * If the triangulation is not connected, the minimum spanning forest is returned.
+         * @param triangulation finished triangulation
+         * @return edges of the tree, in ascending order of their length (the merge order of single-linkage clustering)
+         */
+        static auto euclidean_minimum_spanning_tree(Delaunay &triangulation) -> std::vector<QuadEdge *>;
+
+        /**
+         * Computes the gabriel graph.
+         * An edge ab is part of the graph if no other point lies inside the circle with diameter ab.
+         * For a delaunay edge it is enough to check the two vertices opposite to it.
+         * @param triangulation finished triangulation
+         * @return edges of the gabriel graph
+         */
+        static auto gabriel_graph(Delaunay &triangulation) -> std::vector<QuadEdge *>;
+
+        /**
+         * Computes the relative neighbourhood graph.
+         * An edge ab is part of the graph if there is no point c with max(|ac|, |bc|) < |ab|,
+         * meaning the lune of a and b is empty.
+         * Only the gabriel edges are candidates, and only the neighbours of a and b have to be checked.
+         * @param triangulation finished triangulation
+         * @return edges of the relative neighbourhood graph
+         */
+        static auto relative_neighbourhood_graph(Delaunay &triangulation) -> std::vector<QuadEdge *>;
+
+        /**
+         * Squared length of an edge
+         * @param edge edge to measure
+         * @return squared euclidean distance between origin and destination
+         */
+        static auto squared_length(QuadEdge *edge) -> scalar_t;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_PROXIMITY_GRAPHS_HPP
@@ -5,10 +5,14 @@
 #include "delaunay/point.hpp"
 #include "delaunay/types.hpp"
 
+#include <cstddef>
+#include <limits>
+#include <utility>
 #include <vector>
 
 namespace delaunay {
     class Delaunay;
+    class ConcurrentInsertion;
 
     /**
      * This class implements the QuadEdge Data structure as described in
@@ -30,11 +34,17 @@ namespace delaunay {
      * Read more here: https://www.cs.cmu.edu/afs/andrew/scs/cs/15-463/2001/pub/src/a2/quadedge.html
      */
     struct QuadEdge {
+        /**
+         * Marks an index that is not set, e.g. the origin index of a dual edge
+         */
+        static constexpr std::size_t INVALID_INDEX = std::numeric_limits<std::size_t>::max();
+
         /**
          * Constructor setting up the default links
          * @param origin origin point of this half edge
+         * @param origin_index index of the origin point in the vertex list of the triangulation
          */
-        explicit QuadEdge(const point_t& origin);
+        QuadEdge(const point_t& origin, std::size_t origin_index);
 
         /**
          * The origin or start point of this edge
@@ -49,6 +59,27 @@ namespace delaunay {
          */
         auto destination() -> point_t const &;
 
+        /**
+         * Index of the origin point in the vertex list of the triangulation
+         * @return origin index, INVALID_INDEX if not set
+         */
+        auto origin_index() -> std::size_t;
+
+        /**
+         * Index of the destination point in the vertex list of the triangulation
+         * Equivalent to this->sym()->origin_index()
+         * @return destination index, INVALID_INDEX if not set
+         */
+        auto destination_index() -> std::size_t;
+
+        /**
+         * Unique id of this quarter edge.
+         * The four quarter edges of an edge have consecutive ids in rot order,
+         * the primary edge being the first one (id % 4 == 0) and its sym the third one (id % 4 == 2)
+         * @return id of this quarter edge
+         */
+        auto id() -> std::size_t;
+
         /**
          * Gets the QuadEdge with the same orientation but opposite direction
          * @return The symmetrical QuadEdge to this one
@@ -134,6 +165,20 @@ namespace delaunay {
         auto is_point_on_left(point_t const &point) -> bool;
 
 
+        /**
+         * Id of the face to the left of this edge, assigned while building the vornoi graph
+         * Equivalent to this->inv_rot()->origin_index()
+         * @return face id, INVALID_INDEX for the outer face
+         */
+        auto left_face_index() -> std::size_t;
+
+        /**
+         * Returns true if the face to the left of this edge is a counter clockwise triangle,
+         * e.g. not the outer face of the triangulation
+         * @return whether the left face is a triangle
+         */
+        auto is_left_face_triangle() -> bool;
+
         /**
          * If this edge is deleted / usable
          * @return true if this edge is usable (has origin and destination)
@@ -151,6 +196,16 @@ namespace delaunay {
          */
         point_t m_origin;
 
+        /**
+         * Index of the origin point in the vertex list of the triangulation
+         */
+        std::size_t m_origin_index;
+
+        /**
+         * Unique id of this quarter edge, see id()
+         */
+        std::size_t m_id;
+
         /**
          * Onext pointer
          * Points to the next edge in the edge ring / face this edge belongs to
@@ -164,6 +219,104 @@ namespace delaunay {
         QuadEdge *p_rot;
 
         friend class delaunay::Delaunay;
+        friend class delaunay::ConcurrentInsertion;
     };
+
+    // The navigation is defined here, so every step of the merge loop can be inlined
+    inline QuadEdge::QuadEdge(const point_t& origin, std::size_t origin_index) :
+        state(EdgeState::DELETED),
+        m_origin(std::move(origin)),
+        m_origin_index(origin_index),
+        m_id(0),
+        p_onext(this),
+        p_rot(this) {}
+
+    inline auto QuadEdge::origin() -> point_t const & {
+        return m_origin;
+    }
+
+    inline auto QuadEdge::destination() -> point_t const & {
+        return this->sym()->origin();
+    }
+
+    inline auto QuadEdge::origin_index() -> std::size_t {
+        return m_origin_index;
+    }
+
+    inline auto QuadEdge::destination_index() -> std::size_t {
+        return this->sym()->origin_index();
+    }
+
+    inline auto QuadEdge::id() -> std::size_t {
+        return m_id;
+    }
+
+    inline auto QuadEdge::sym() -> QuadEdge * {
+        // e Sym = e Rot²
+        return this->p_rot->p_rot;
+    }
+
+    inline auto QuadEdge::orbit_next() -> QuadEdge * {
+        // e Oprev = e Onext⁻¹ = e Rot Onext Rot
+        return this->p_onext;
+    }
+
+    inline auto QuadEdge::orbit_prev() -> QuadEdge * {
+        // e Oprev = e Onext⁻¹ = e Rot Onext Rot
+        return this->p_rot->p_onext->p_rot;
+    }
+
+    inline auto QuadEdge::left_face_next() -> QuadEdge * {
+        // e Lnext = e Rot⁻¹ Onext Rot,
+        return this->inv_rot()->p_onext->p_rot;
+    }
+
+    inline auto QuadEdge::left_face_prev() -> QuadEdge * {
+        // e Lprev = e Lnext⁻¹ = e Onext Sym
+        return this->p_onext->sym();
+    }
+
+    inline auto QuadEdge::right_face_next() -> QuadEdge * {
+        // e Rnext = e Rot Onext Rot⁻¹
+        return this->p_rot->p_onext->inv_rot();
+    }
+
+    inline auto QuadEdge::rot() -> QuadEdge * {
+        // eRot
+        return this->p_rot;
+    }
+
+    inline auto QuadEdge::right_face_prev() -> QuadEdge * {
+        // e Rprev = e Rnext⁻¹ = e Sym Onext
+        return this->sym()->p_onext;
+    }
+
+    inline auto QuadEdge::inv_rot() -> QuadEdge * {
+        // eRot⁻¹ = eRot³ = eRotRotRot
+        return rot()->rot()->rot();
+    }
+
+    inline auto QuadEdge::is_point_on_right(point_t const &point) -> bool {
+        return point_t::counter_clock_wise(point, this->destination(), this->origin());
+    }
+
+    inline auto QuadEdge::is_point_on_left(point_t const &point) -> bool {
+        return point_t::counter_clock_wise(point, this->origin(), this->destination());
+    }
+
+    inline auto QuadEdge::left_face_index() -> std::size_t {
+        return this->inv_rot()->origin_index();
+    }
+
+    inline auto QuadEdge::is_left_face_triangle() -> bool {
+        QuadEdge *next = this->left_face_next();
+        return next->left_face_next()->left_face_next() == this &&
+               point_t::counter_clock_wise(this->origin(), this->destination(), next->destination());
+    }
+
+    inline auto QuadEdge::is_deleted() -> bool {
+        return this->state == EdgeState::DELETED || this->origin().x == std::numeric_limits<scalar_t>::infinity() ||
+               this->destination().x == std::numeric_limits<scalar_t>::infinity() || this->sym() == nullptr;
+    }
 }// namespace analyser
 #endif// AS_DATA_RECORDER_QUAD_EDGE_HPP
@@ -0,0 +1,277 @@
+#ifndef DELAUNAY_SWEEP_HULL_HPP
+#define DELAUNAY_SWEEP_HULL_HPP
+
+#include "delaunay/point.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Delaunay triangulation by radial sweep-hull (as in Delaunator), stored in flat uint32_t arrays.
+     *
+     * The points are inserted in order of their distance to a seed triangle. Each new point lies outside the
+     * current hull, the first visible hull edge is found through a hash of the hull vertices by angle, and the
+     * new triangles are legalized with flips. Instead of four linked quarter edges per edge, a triangle is three
+     * consecutive half edges plus the index of the opposite half edge, which is far more compact and cache friendly
+     * than Delaunay for large inputs. There is no vornoi graph.
+     *
+     * HalfEdge exposes the primal navigation of QuadEdge (origin, sym, left_face_next, orbit_next, ...),
+     * including the outer face, so code walking the edges of a Delaunay works on both engines.
+     * Vertices are the given points in input order. Duplicates (and points the predicates cannot place)
+     * are skipped and have no edges.
+     */
+    class SweepHull {
+      public:
+        /**
+         * Marks a missing index, e.g. the opposite of a half edge on the hull
+         */
+        static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+        /**
+         * Handle of a half edge, navigating like a QuadEdge.
+         * Half edges of the triangles have the ids 0 .. 3 * triangle count, the half edges of the outer face
+         * (the other side of the hull edges) follow after them. The handle is pointer like,
+         * edge->origin() works like for QuadEdge*.
+         */
+        class HalfEdge {
+          public:
+            HalfEdge(SweepHull const *mesh, std::uint32_t id);
+
+            /**
+             * Unique id of this half edge
+             * @return id, an index into get_triangles() / get_half_edges() for half edges of triangles
+             */
+            [[nodiscard]] auto id() const -> std::uint32_t;
+
+            /**
+             * The origin or start point of this edge
+             * @return origin point
+             */
+            [[nodiscard]] auto origin() const -> point_t const &;
+
+            /**
+             * The destination or end point of this edge
+             * @return destination point
+             */
+            [[nodiscard]] auto destination() const -> point_t const &;
+
+            /**
+             * Index of the origin point in the vertex list
+             * @return origin index
+             */
+            [[nodiscard]] auto origin_index() const -> std::size_t;
+
+            /**
+             * Index of the destination point in the vertex list
+             * @return destination index
+             */
+            [[nodiscard]] auto destination_index() const -> std::size_t;
+
+            /**
+             * The same edge in the opposite direction
+             * @return symmetrical half edge
+             */
+            [[nodiscard]] auto sym() const -> HalfEdge;
+
+            /**
+             * Counter clockwise rotation around the origin vertex of this edge
+             * @return the next edge in counter clockwise direction of this edges origin vertex
+             */
+            [[nodiscard]] auto orbit_next() const -> HalfEdge;
+
+            /**
+             * Clockwise rotation around the origin vertex of this edge
+             * @return the next edge in clockwise direction of this edges origin vertex
+             */
+            [[nodiscard]] auto orbit_prev() const -> HalfEdge;
+
+            /**
+             * The next (moving counter clockwise) edge in the face that is on the left to this one
+             * @return next edge in the left face
+             */
+            [[nodiscard]] auto left_face_next() const -> HalfEdge;
+
+            /**
+             * The prev (moving clockwise) edge in the face that is on the left to this one
+             * @return prev edge in the left face
+             */
+            [[nodiscard]] auto left_face_prev() const -> HalfEdge;
+
+            /**
+             * Id of the triangle to the left of this edge, its position in get_triangles() divided by three
+             * @return face id, QuadEdge::INVALID_INDEX (the std::size_t maximum) for the outer face
+             */
+            [[nodiscard]] auto left_face_index() const -> std::size_t;
+
+            /**
+             * Returns true if the face to the left of this edge is a triangle, e.g. not the outer face
+             * @return whether the left face is a triangle
+             */
+            [[nodiscard]] auto is_left_face_triangle() const -> bool;
+
+            /**
+             * Edges are never deleted, present for parity with QuadEdge
+             * @return false
+             */
+            [[nodiscard]] auto is_deleted() const -> bool;
+
+            /**
+             * Pointer like access, so edge->origin() works as for QuadEdge*
+             * @return this handle
+             */
+            auto operator->() const -> HalfEdge const *;
+
+            auto operator==(HalfEdge const &other) const -> bool = default;
+
+          private:
+            /**
+             * Whether this is a half edge of the outer face
+             */
+            [[nodiscard]] auto is_outer() const -> bool;
+
+            SweepHull const *mesh;
+            std::uint32_t edge_id;
+        };
+
+        /**
+         * Triangulate the points
+         * @param points points to triangulate, not modified
+         * @param resource memory resource for all allocations of the triangulation
+         * @return the triangulation
+         */
+        static auto triangulate(std::span<point_t const> points,
+                                std::pmr::memory_resource *resource = std::pmr::get_default_resource()) -> SweepHull;
+
+        /**
+         * Get the vertices, the given points in input order
+         * @return view of points
+         */
+        [[nodiscard]] auto get_vertices() const -> std::span<point_t const>;
+
+        /**
+         * Get the triangles as three vertex indices per triangle (counter clockwise).
+         * Entry i is also the origin of half edge i, which runs to the next vertex of its triangle.
+         * @return view of vertex indices
+         */
+        [[nodiscard]] auto get_triangles() const -> std::span<std::uint32_t const>;
+
+        /**
+         * Get the opposite of every half edge of the triangles
+         * @return view of half edge ids, INVALID_INDEX for hull edges
+         */
+        [[nodiscard]] auto get_half_edges() const -> std::span<std::uint32_t const>;
+
+        /**
+         * Get the vertices of the convex hull
+         * @return vertex indices in counter clockwise order
+         */
+        [[nodiscard]] auto get_hull() const -> std::span<std::uint32_t const>;
+
+        /**
+         * Get one half edge per edge, like Delaunay::get_primary_edges()
+         * @return half edges
+         */
+        [[nodiscard]] auto get_primary_edges() const -> std::vector<HalfEdge>;
+
+        /**
+         * Get the edges of the convex hull, like Delaunay::get_convex_hull()
+         * @return hull edges in counter clockwise order, with the triangulation on their left
+         */
+        [[nodiscard]] auto get_convex_hull() const -> std::vector<HalfEdge>;
+
+      private:
+        explicit SweepHull(std::pmr::memory_resource *resource);
+
+        /**
+         * Runs the sweep over all vertices
+         */
+        void build();
+
+        /**
+         * Appends a triangle
+         * @param a first vertex
+         * @param b second vertex
+         * @param c third vertex
+         * @param ab opposite of the half edge a -> b
+         * @param bc opposite of the half edge b -> c
+         * @param ca opposite of the half edge c -> a
+         * @return id of the half edge a -> b
+         */
+        auto add_triangle(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t ab, std::uint32_t bc,
+                          std::uint32_t ca) -> std::uint32_t;
+
+        /**
+         * Makes two half edges opposite of each other, a hull edge if b is INVALID_INDEX
+         * @param a half edge
+         * @param b half edge or INVALID_INDEX
+         */
+        void link(std::uint32_t a, std::uint32_t b);
+
+        /**
+         * Flips edges until the triangles around the half edge are locally Delaunay again
+         * @param edge half edge opposite of the new vertex
+         */
+        void legalize(std::uint32_t edge);
+
+        /**
+         * Bucket of a point in the hull hash, by its angle around the center
+         * @param point point
+         * @return bucket
+         */
+        [[nodiscard]] auto hash_key(point_t const &point) const -> std::size_t;
+
+        std::pmr::vector<point_t> vertices;
+
+        /**
+         * Three vertex indices per triangle
+         */
+        std::pmr::vector<std::uint32_t> triangles;
+
+        /**
+         * Opposite of every half edge
+         */
+        std::pmr::vector<std::uint32_t> half_edges;
+
+        /**
+         * Hull vertices, counter clockwise
+         */
+        std::pmr::vector<std::uint32_t> hull;
+
+        /**
+         * Next hull vertex (counter clockwise) of every hull vertex, a removed vertex points to itself
+         */
+        std::pmr::vector<std::uint32_t> hull_next;
+
+        /**
+         * Previous hull vertex (clockwise) of every hull vertex
+         */
+        std::pmr::vector<std::uint32_t> hull_prev;
+
+        /**
+         * Half edge from every hull vertex to its next hull vertex
+         */
+        std::pmr::vector<std::uint32_t> hull_edges;
+
+        /**
+         * Hull vertices bucketed by angle around the center, for finding a visible hull edge
+         */
+        std::pmr::vector<std::uint32_t> hull_hash;
+
+        /**
+         * Pending half edges of legalize()
+         */
+        std::pmr::vector<std::uint32_t> edge_stack;
+
+        /**
+         * Center of the seed triangle, all angles are measured around it
+         */
+        point_t center;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_SWEEP_HULL_HPP
@@ -0,0 +1,57 @@
+#include "delaunay/allocation_statistics.hpp"
+
+namespace delaunay {
+    AllocationStatistics::AllocationStatistics(std::pmr::memory_resource *upstream) : upstream_resource(upstream) {}
+
+    auto AllocationStatistics::upstream() const -> std::pmr::memory_resource * {
+        return upstream_resource;
+    }
+
+    auto AllocationStatistics::bytes_in_use() const -> std::size_t {
+        return in_use.load();
+    }
+
+    auto AllocationStatistics::peak_bytes() const -> std::size_t {
+        return peak.load();
+    }
+
+    auto AllocationStatistics::total_bytes() const -> std::size_t {
+        return total.load();
+    }
+
+    auto AllocationStatistics::allocation_count() const -> std::size_t {
+        return allocations.load();
+    }
+
+    auto AllocationStatistics::deallocation_count() const -> std::size_t {
+        return deallocations.load();
+    }
+
+    void AllocationStatistics::reset_peak() {
+        peak = in_use.load();
+    }
+
+    auto AllocationStatistics::do_allocate(std::size_t bytes, std::size_t alignment) -> void * {
+        void *pointer = upstream_resource->allocate(bytes, alignment);
+
+        std::size_t const now_in_use = in_use += bytes;
+        total += bytes;
+        allocations++;
+
+        // Raise the peak, unless another thread already raised it further
+        std::size_t current_peak = peak.load();
+        while (now_in_use > current_peak && !peak.compare_exchange_weak(current_peak, now_in_use)) {
+        }
+        return pointer;
+    }
+
+    void AllocationStatistics::do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) {
+        upstream_resource->deallocate(pointer, bytes, alignment);
+        in_use -= bytes;
+        deallocations++;
+    }
+
+    auto AllocationStatistics::do_is_equal(std::pmr::memory_resource const &other) const noexcept -> bool {
+        return this == &other;
+    }
+}// namespace delaunay
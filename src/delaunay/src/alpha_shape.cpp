@@ -0,0 +1,176 @@
+#include "delaunay/alpha_shape.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace delaunay {
+    namespace {
+        constexpr scalar_t INFINITE_ALPHA = std::numeric_limits<scalar_t>::infinity();
+
+        auto distance(point_t const &a, point_t const &b) -> scalar_t {
+            return std::hypot(a.x - b.x, a.y - b.y);
+        }
+
+        /**
+         * Returns whether an edge leaving the boundary at death is still on the boundary at alpha.
+         * Edges of the outer face never leave the boundary.
+         */
+        auto is_on_boundary(scalar_t death, scalar_t alpha) -> bool {
+            return death > alpha || death == INFINITE_ALPHA;
+        }
+    }// namespace
+
+    AlphaShape::AlphaShape(Delaunay &triangulation) : tree_leaves(1) {
+        auto const &vertices = triangulation.get_vertices();
+        auto const &faces = triangulation.get_faces();
+        auto const &circumcenters = triangulation.get_circumcenters();
+
+        // Triangles enter the complex at their circumradius
+        std::size_t const face_count = circumcenters.size();
+        face_alphas.resize(face_count);
+        parallel::parallel_for(face_count, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t face = begin; face < end; face++) {
+                face_alphas[face] = distance(circumcenters[face], vertices[faces[3 * face]]);
+            }
+        });
+
+        sorted_faces.resize(face_count);
+        std::iota(sorted_faces.begin(), sorted_faces.end(), std::size_t{0});
+        parallel::sort(sorted_faces.begin(), sorted_faces.end(), [this](std::size_t a, std::size_t b) {
+            return face_alphas[a] < face_alphas[b];
+        });
+
+        sorted_face_alphas.resize(face_count);
+        for (std::size_t i = 0; i < face_count; i++) {
+            sorted_face_alphas[i] = face_alphas[sorted_faces[i]];
+        }
+
+        // Edges enter the complex at half their length if their diametral circle is empty,
+        // otherwise together with their smallest triangle
+        struct EdgeEntry {
+            scalar_t birth;
+            scalar_t death;
+            QuadEdge *edge;
+        };
+
+        std::vector<EdgeEntry> entries;
+        entries.reserve(triangulation.get_primary_edges().size());
+        for (QuadEdge *edge : triangulation.get_primary_edges()) {
+            if (!edge->is_deleted()) {
+                entries.push_back({0, 0, edge});
+            }
+        }
+
+        parallel::parallel_for(entries.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                QuadEdge *edge = entries[i].edge;
+                point_t const &a = edge->origin();
+                point_t const &b = edge->destination();
+                point_t const middle((a.x + b.x) / 2, (a.y + b.y) / 2);
+                scalar_t const radius = distance(a, b) / 2;
+
+                bool attached = false;
+                for (QuadEdge *side : {edge, edge->sym()}) {
+                    if (side->is_left_face_triangle()) {
+                        attached = attached || distance(middle, side->left_face_next()->destination()) < radius;
+                    }
+                }
+
+                scalar_t const left = left_face_alpha(edge);
+                scalar_t const right = left_face_alpha(edge->sym());
+                entries[i].birth = attached ? std::min(left, right) : radius;
+                entries[i].death = std::max(left, right);
+            }
+        });
+
+        parallel::sort(entries.begin(), entries.end(), [](EdgeEntry const &a, EdgeEntry const &b) {
+            return a.birth < b.birth;
+        });
+
+        while (tree_leaves < entries.size()) {
+            tree_leaves *= 2;
+        }
+
+        sorted_edges.resize(entries.size());
+        edge_births.resize(entries.size());
+        edge_deaths.assign(2 * tree_leaves, -INFINITE_ALPHA);
+        for (std::size_t i = 0; i < entries.size(); i++) {
+            sorted_edges[i] = entries[i].edge;
+            edge_births[i] = entries[i].birth;
+            edge_deaths[tree_leaves + i] = entries[i].death;
+        }
+        for (std::size_t node = tree_leaves - 1; node > 0; node--) {
+            edge_deaths[node] = std::max(edge_deaths[2 * node], edge_deaths[2 * node + 1]);
+        }
+    }
+
+    auto AlphaShape::left_face_alpha(QuadEdge *edge) -> scalar_t {
+        std::size_t const face = edge->left_face_index();
+        return face == QuadEdge::INVALID_INDEX ? INFINITE_ALPHA : face_alphas[face];
+    }
+
+    auto AlphaShape::is_left_face_in_complex(QuadEdge *edge, scalar_t alpha) -> bool {
+        std::size_t const face = edge->left_face_index();
+        return face != QuadEdge::INVALID_INDEX && face_alphas[face] <= alpha;
+    }
+
+    auto AlphaShape::get_boundary(scalar_t alpha) -> std::vector<QuadEdge *> {
+        std::vector<QuadEdge *> boundary;
+
+        // Only edges born until alpha are candidates, they form a prefix of the sorted edges
+        auto const candidates = static_cast<std::size_t>(
+            std::upper_bound(edge_births.begin(), edge_births.end(), alpha) - edge_births.begin()
+        );
+        if (candidates == 0) {
+            return boundary;
+        }
+
+        // Descend into every subtree intersecting the prefix that still has an edge on the boundary
+        struct Range {
+            std::size_t node;
+            std::size_t first_leaf;
+            std::size_t width;
+        };
+
+        std::vector<Range> to_visit{{1, 0, tree_leaves}};
+        while (!to_visit.empty()) {
+            Range const range = to_visit.back();
+            to_visit.pop_back();
+
+            if (range.first_leaf >= candidates || !is_on_boundary(edge_deaths[range.node], alpha)) {
+                continue;
+            }
+
+            if (range.width == 1) {
+                // Orient the edge so the triangle inside the complex is on its left
+                QuadEdge *edge = sorted_edges[range.first_leaf];
+                bool const flip = !is_left_face_in_complex(edge, alpha) && is_left_face_in_complex(edge->sym(), alpha);
+                boundary.push_back(flip ? edge->sym() : edge);
+                continue;
+            }
+
+            std::size_t const half = range.width / 2;
+            to_visit.push_back({2 * range.node + 1, range.first_leaf + half, half});
+            to_visit.push_back({2 * range.node, range.first_leaf, half});
+        }
+
+        return boundary;
+    }
+
+    auto AlphaShape::get_face_count(scalar_t alpha) const -> std::size_t {
+        return static_cast<std::size_t>(
+            std::upper_bound(sorted_face_alphas.begin(), sorted_face_alphas.end(), alpha) - sorted_face_alphas.begin()
+        );
+    }
+
+    auto AlphaShape::get_sorted_faces() -> std::vector<std::size_t> const & {
+        return sorted_faces;
+    }
+
+    auto AlphaShape::get_face_alphas() -> std::vector<scalar_t> const & {
+        return face_alphas;
+    }
+}// namespace delaunay
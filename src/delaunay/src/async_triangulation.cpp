@@ -0,0 +1,104 @@
+#include "delaunay/async_triangulation.hpp"
+
+#include <exception>
+#include <utility>
+
+namespace delaunay {
+    TriangulationCancelled::TriangulationCancelled() :
+        std::runtime_error("triangulation was replaced by a newer submission") {}
+
+    AsyncTriangulation::AsyncTriangulation(std::pmr::memory_resource *resource) :
+        resource(resource),
+        worker([this]() { work(); }) {}
+
+    AsyncTriangulation::~AsyncTriangulation() {
+        {
+            std::lock_guard const lock(mutex);
+            stopping = true;
+            if (running != nullptr) {
+                *running = true;
+            }
+            if (pending.has_value()) {
+                pending->promise.set_exception(std::make_exception_ptr(TriangulationCancelled()));
+                pending.reset();
+            }
+        }
+        job_available.notify_one();
+        worker.join();
+    }
+
+    auto AsyncTriangulation::submit(std::vector<point_t> points) -> std::future<result_t> {
+        Job job{std::move(points), {}, nullptr, std::make_shared<std::atomic<bool>>(false)};
+        auto future = job.promise.get_future();
+        enqueue(std::move(job));
+        return future;
+    }
+
+    void AsyncTriangulation::submit(std::vector<point_t> points, callback_t callback) {
+        enqueue({std::move(points), {}, std::move(callback), std::make_shared<std::atomic<bool>>(false)});
+    }
+
+    auto AsyncTriangulation::latest() const -> result_t {
+        return results.read();
+    }
+
+    void AsyncTriangulation::enqueue(Job job) {
+        {
+            std::lock_guard const lock(mutex);
+            if (running != nullptr) {
+                *running = true;
+            }
+            if (pending.has_value()) {
+                pending->promise.set_exception(std::make_exception_ptr(TriangulationCancelled()));
+            }
+            pending = std::move(job);
+        }
+        job_available.notify_one();
+    }
+
+    void AsyncTriangulation::work() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock lock(mutex);
+                job_available.wait(lock, [this]() { return stopping || pending.has_value(); });
+                if (stopping) {
+                    return;
+                }
+                job = std::move(*pending);
+                pending.reset();
+                running = job.cancelled;
+            }
+
+            result_t result;
+            try {
+                // The constructor is private, so the result is created here instead of with make_shared
+                result.reset(new Delaunay(resource));
+                result->cancel_flag = job.cancelled.get();
+                if (job.points.size() >= 3) {
+                    result->set_vertices(job.points);
+                    result->build();
+                }
+                result->cancel_flag = nullptr;
+            } catch (...) {
+                job.promise.set_exception(std::current_exception());
+                result = nullptr;
+            }
+
+            if (result != nullptr) {
+                if (*job.cancelled) {
+                    job.promise.set_exception(std::make_exception_ptr(TriangulationCancelled()));
+                } else {
+                    results.publish(result);
+                    job.promise.set_value(result);
+                    if (job.callback) {
+                        job.callback(result);
+                    }
+                }
+            }
+
+            std::lock_guard const lock(mutex);
+            running = nullptr;
+        }
+    }
+}// namespace delaunay
@@ -0,0 +1,47 @@
+#include "delaunay/delaunay.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+
+namespace delaunay {
+    auto Delaunay::get_face_areas() -> std::span<scalar_t const> {
+        std::size_t const face_count = face_edges.size();
+        if (face_areas.size() == face_count) {
+            return face_areas;
+        }
+
+        face_areas.assign(face_count, 0);
+        parallel::parallel_for(face_count, [this](std::size_t begin, std::size_t end) {
+            std::size_t const *face = faces.data();
+            point_t const *points = vertices.data();
+            scalar_t *result = face_areas.data();
+
+            for (std::size_t i = begin; i < end; i++) {
+                point_t const &a = points[face[3 * i]];
+                point_t const &b = points[face[3 * i + 1]];
+                point_t const &c = points[face[3 * i + 2]];
+                result[i] = ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2;
+            }
+        });
+        return face_areas;
+    }
+
+    void Delaunay::remove_vertex_attribute(std::string_view name) {
+        std::erase_if(vertex_attributes, [name](auto const &channel) { return channel->name() == name; });
+    }
+
+    auto Delaunay::find_vertex_attribute(std::string_view name) -> AttributeChannel * {
+        auto const channel = std::find_if(vertex_attributes.begin(), vertex_attributes.end(),
+                                          [name](auto const &candidate) { return candidate->name() == name; });
+        return channel == vertex_attributes.end() ? nullptr : channel->get();
+    }
+
+    void Delaunay::remap_vertex_attributes(std::span<std::size_t const> origins, std::span<std::size_t const> inputs) {
+        // Every channel is an independent array, one task each
+        if (vertex_attributes.empty()) {
+            return;
+        }
+        parallel::run_tasks(vertex_attributes.size(),
+                            [&](std::size_t channel) { vertex_attributes[channel]->remap(origins, inputs); });
+    }
+}// namespace delaunay
@@ -0,0 +1,135 @@
+#include "delaunay/batch_triangulation.hpp"
+#include "delaunay/delaunay.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace delaunay {
+    namespace {
+        /**
+         * Results of all sets processed by one worker, stored one after another
+         */
+        struct WorkerOutput {
+            std::vector<point_t> vertices;
+            std::vector<std::size_t> vertex_origins;
+            std::vector<std::size_t> faces;
+            std::vector<std::size_t> edges;
+        };
+
+        /**
+         * Location of the results of one set in the output of its worker
+         */
+        struct SetLocation {
+            std::size_t worker;
+            std::size_t vertex_begin;
+            std::size_t face_begin;
+            std::size_t edge_begin;
+        };
+    }// namespace
+
+    auto BatchTriangulation::triangulate(std::span<std::span<point_t const> const> point_sets,
+                                         std::pmr::memory_resource *resource) -> BatchTriangulation {
+        BatchTriangulation result;
+        std::size_t const set_count = point_sets.size();
+
+        ThreadPool &pool = ThreadPool::instance();
+        std::size_t const workers = std::min(pool.size(), set_count);
+
+        std::vector<WorkerOutput> outputs(workers);
+        std::vector<SetLocation> locations(set_count);
+        result.vertex_offsets.assign(set_count + 1, 0);
+        result.face_offsets.assign(set_count + 1, 0);
+        result.edge_offsets.assign(set_count + 1, 0);
+
+        // Sets are handed out one by one, as their sizes can differ a lot
+        std::atomic<std::size_t> next_set{0};
+        pool.run(workers, [&](std::size_t worker) {
+            // Every worker keeps one triangulation for this call, so its edge storage is reused by all its sets
+            Delaunay workspace(resource);
+            WorkerOutput &output = outputs[worker];
+
+            for (std::size_t set = next_set++; set < set_count; set = next_set++) {
+                locations[set] = {worker, output.vertices.size(), output.faces.size(), output.edges.size()};
+
+                workspace.clear();
+                auto const &points = point_sets[set];
+                if (points.size() >= 3) {
+                    workspace.set_vertices(points);
+                    workspace.build();
+                }
+
+                output.vertices.insert(output.vertices.end(), workspace.vertices.begin(), workspace.vertices.end());
+                output.vertex_origins.insert(output.vertex_origins.end(), workspace.vertex_origins.begin(),
+                                             workspace.vertex_origins.end());
+                output.faces.insert(output.faces.end(), workspace.faces.begin(), workspace.faces.end());
+                for (QuadEdge *edge : workspace.primary_edges) {
+                    if (!edge->is_deleted()) {
+                        output.edges.push_back(edge->origin_index());
+                        output.edges.push_back(edge->destination_index());
+                    }
+                }
+
+                // Sizes are stored shifted by one, the prefix sum turns them into offsets
+                result.vertex_offsets[set + 1] = output.vertices.size() - locations[set].vertex_begin;
+                result.face_offsets[set + 1] = output.faces.size() - locations[set].face_begin;
+                result.edge_offsets[set + 1] = output.edges.size() - locations[set].edge_begin;
+            }
+        });
+
+        for (std::size_t set = 0; set < set_count; set++) {
+            result.vertex_offsets[set + 1] += result.vertex_offsets[set];
+            result.face_offsets[set + 1] += result.face_offsets[set];
+            result.edge_offsets[set + 1] += result.edge_offsets[set];
+        }
+
+        result.vertices.resize(result.vertex_offsets[set_count], point_t(0, 0));
+        result.vertex_origins.resize(result.vertex_offsets[set_count]);
+        result.faces.resize(result.face_offsets[set_count]);
+        result.edges.resize(result.edge_offsets[set_count]);
+
+        // Gather the results of all workers in set order
+        next_set = 0;
+        pool.run(workers, [&](std::size_t /*worker*/) {
+            for (std::size_t set = next_set++; set < set_count; set = next_set++) {
+                SetLocation const &location = locations[set];
+                WorkerOutput const &output = outputs[location.worker];
+
+                std::copy_n(output.vertices.begin() + static_cast<std::ptrdiff_t>(location.vertex_begin),
+                            result.vertex_offsets[set + 1] - result.vertex_offsets[set],
+                            result.vertices.begin() + static_cast<std::ptrdiff_t>(result.vertex_offsets[set]));
+                std::copy_n(output.vertex_origins.begin() + static_cast<std::ptrdiff_t>(location.vertex_begin),
+                            result.vertex_offsets[set + 1] - result.vertex_offsets[set],
+                            result.vertex_origins.begin() + static_cast<std::ptrdiff_t>(result.vertex_offsets[set]));
+                std::copy_n(output.faces.begin() + static_cast<std::ptrdiff_t>(location.face_begin),
+                            result.face_offsets[set + 1] - result.face_offsets[set],
+                            result.faces.begin() + static_cast<std::ptrdiff_t>(result.face_offsets[set]));
+                std::copy_n(output.edges.begin() + static_cast<std::ptrdiff_t>(location.edge_begin),
+                            result.edge_offsets[set + 1] - result.edge_offsets[set],
+                            result.edges.begin() + static_cast<std::ptrdiff_t>(result.edge_offsets[set]));
+            }
+        });
+
+        return result;
+    }
+
+    auto BatchTriangulation::size() const -> std::size_t {
+        return vertex_offsets.empty() ? 0 : vertex_offsets.size() - 1;
+    }
+
+    auto BatchTriangulation::get_vertices(std::size_t set) const -> std::span<point_t const> {
+        return std::span(vertices).subspan(vertex_offsets[set], vertex_offsets[set + 1] - vertex_offsets[set]);
+    }
+
+    auto BatchTriangulation::get_vertex_origins(std::size_t set) const -> std::span<std::size_t const> {
+        return std::span(vertex_origins).subspan(vertex_offsets[set], vertex_offsets[set + 1] - vertex_offsets[set]);
+    }
+
+    auto BatchTriangulation::get_faces(std::size_t set) const -> std::span<std::size_t const> {
+        return std::span(faces).subspan(face_offsets[set], face_offsets[set + 1] - face_offsets[set]);
+    }
+
+    auto BatchTriangulation::get_edges(std::size_t set) const -> std::span<std::size_t const> {
+        return std::span(edges).subspan(edge_offsets[set], edge_offsets[set + 1] - edge_offsets[set]);
+    }
+}// namespace delaunay
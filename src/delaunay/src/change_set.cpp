@@ -0,0 +1,268 @@
+#include "delaunay/delaunay.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace delaunay {
+    namespace {
+        using edge_t = std::array<std::size_t, 2>;
+        using face_t = std::array<std::size_t, 3>;
+
+        /**
+         * Rotates a face to start at its smallest vertex, keeping the orientation
+         */
+        auto canonical_face(std::size_t a, std::size_t b, std::size_t c) -> face_t {
+            if (a < b && a < c) {
+                return {a, b, c};
+            }
+            if (b < c) {
+                return {b, c, a};
+            }
+            return {c, a, b};
+        }
+
+        /**
+         * Sorts a list and removes duplicates
+         */
+        template<class T>
+        void sort_unique(std::pmr::vector<T> &values) {
+            std::sort(values.begin(), values.end());
+            values.erase(std::unique(values.begin(), values.end()), values.end());
+        }
+
+        /**
+         * Canonical triangles of a face list having a candidate vertex
+         * @param faces three vertex indices per face
+         * @param candidate marks the vertices whose faces are compared
+         * @param resource memory resource of the result
+         * @return sorted faces
+         */
+        auto local_faces(std::span<std::size_t const> faces, std::pmr::vector<char> const &candidate,
+                         std::pmr::memory_resource *resource) -> std::pmr::vector<face_t> {
+            std::pmr::vector<face_t> result(resource);
+            for (std::size_t i = 0; i + 2 < faces.size(); i += 3) {
+                std::size_t const a = faces[i];
+                std::size_t const b = faces[i + 1];
+                std::size_t const c = faces[i + 2];
+
+                // Faces of vertices merged by a rebuild collapse
+                if (a == b || b == c || c == a) {
+                    continue;
+                }
+                if (candidate[a] != 0 || candidate[b] != 0 || candidate[c] != 0) {
+                    result.push_back(canonical_face(a, b, c));
+                }
+            }
+            sort_unique(result);
+            return result;
+        }
+
+        /**
+         * Edges of the faces, the smaller vertex first
+         */
+        auto face_sides(std::pmr::vector<face_t> const &faces) -> std::pmr::vector<edge_t> {
+            std::pmr::vector<edge_t> result(faces.get_allocator());
+            result.reserve(3 * faces.size());
+            for (auto const &face : faces) {
+                for (std::size_t i = 0; i < 3; i++) {
+                    std::size_t const a = face[i];
+                    std::size_t const b = face[(i + 1) % 3];
+                    result.push_back({std::min(a, b), std::max(a, b)});
+                }
+            }
+            sort_unique(result);
+            return result;
+        }
+
+        /**
+         * Elements of the sorted list a missing in the sorted list b
+         */
+        template<class T>
+        auto difference(std::pmr::vector<T> const &a, std::pmr::vector<T> const &b) -> std::pmr::vector<T> {
+            std::pmr::vector<T> result(a.get_allocator());
+            std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Union of two sorted lists
+         */
+        template<class T>
+        auto combine(std::pmr::vector<T> const &a, std::pmr::vector<T> const &b) -> std::pmr::vector<T> {
+            std::pmr::vector<T> result(a.get_allocator());
+            std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Adds the changes of one operation to those of the epoch, churn cancels out
+         * @param created created in the epoch so far
+         * @param deleted deleted in the epoch so far
+         * @param now_created created by the operation
+         * @param now_deleted deleted by the operation
+         */
+        template<class T>
+        void apply_delta(std::pmr::vector<T> &created, std::pmr::vector<T> &deleted,
+                         std::pmr::vector<T> const &now_created, std::pmr::vector<T> const &now_deleted) {
+            // Created and deleted again within the epoch, or deleted and restored, never changed for the consumer
+            auto const fresh_created = difference(now_created, deleted);
+            auto const fresh_deleted = difference(now_deleted, created);
+            created = combine(difference(created, now_deleted), fresh_created);
+            deleted = combine(difference(deleted, now_created), fresh_deleted);
+        }
+    }// namespace
+
+    void Delaunay::track_changes(bool enabled) {
+        changes_tracked = enabled;
+        previous_faces.clear();
+        touched_vertices.clear();
+        moved_vertices.clear();
+    }
+
+    auto Delaunay::get_changes() -> ChangeSet const & {
+        return changes;
+    }
+
+    auto Delaunay::clear_changes() -> std::uint64_t {
+        changes.created_edges.clear();
+        changes.deleted_edges.clear();
+        changes.created_faces.clear();
+        changes.deleted_faces.clear();
+        changes.removed_edges.clear();
+        changes.removed_faces.clear();
+        changes.dirty_vertices.clear();
+        changes.renumbered_vertices.clear();
+        return ++changes.epoch;
+    }
+
+    void Delaunay::touch_vertex(std::size_t vertex) {
+        if (changes_tracked) {
+            touched_vertices.push_back(vertex);
+        }
+    }
+
+    void Delaunay::record_changes(std::span<std::size_t const> renumbering, bool everything) {
+        if (!changes_tracked) {
+            return;
+        }
+        renumber_changes(renumbering);
+
+        // Every changed face has a touched vertex, either before or after the change,
+        // so only the faces around touched vertices are compared
+        std::pmr::memory_resource *resource = memory_resource();
+        std::pmr::vector<char> candidate(vertices.size(), everything ? 1 : 0, resource);
+        for (std::size_t vertex : touched_vertices) {
+            candidate[vertex] = 1;
+        }
+        auto const before = local_faces(previous_faces, candidate, resource);
+        auto const after = local_faces(faces, candidate, resource);
+        auto const edges_before = face_sides(before);
+        auto const edges_after = face_sides(after);
+
+        auto const created_edges = difference(edges_after, edges_before);
+        auto const deleted_edges = difference(edges_before, edges_after);
+        apply_delta(changes.created_faces, changes.deleted_faces, difference(after, before), difference(before, after));
+        apply_delta(changes.created_edges, changes.deleted_edges, created_edges, deleted_edges);
+
+        // Moved vertices and the ends of changed edges are dirty
+        std::pmr::vector<std::size_t> dirty(moved_vertices, resource);
+        for (auto const &edges : {&created_edges, &deleted_edges}) {
+            for (auto const &edge : *edges) {
+                dirty.push_back(edge[0]);
+                dirty.push_back(edge[1]);
+            }
+        }
+        sort_unique(dirty);
+        changes.dirty_vertices = combine(changes.dirty_vertices, dirty);
+
+        previous_faces.clear();
+        touched_vertices.clear();
+        moved_vertices.clear();
+    }
+
+    void Delaunay::renumber_changes(std::span<std::size_t const> renumbering) {
+        if (!changes_tracked || renumbering.empty()) {
+            return;
+        }
+
+        // Removed vertices have no new index, changes at them can not be given in the new numbering
+        static constexpr std::size_t REMOVED = QuadEdge::INVALID_INDEX;
+        auto const renumber = [renumbering](std::size_t vertex) {
+            return vertex == REMOVED ? REMOVED : renumbering[vertex];
+        };
+
+        // Deletions at removed vertices move to the removed lists, in the numbering at the start of the epoch.
+        // Their vertices all existed then, anything created since cancelled out when it was deleted
+        std::pmr::vector<std::size_t> original(renumbering.size(), REMOVED, memory_resource());
+        if (changes.renumbered_vertices.empty()) {
+            std::iota(original.begin(), original.end(), 0);
+        } else {
+            for (std::size_t vertex = 0; vertex < changes.renumbered_vertices.size(); vertex++) {
+                if (changes.renumbered_vertices[vertex] != REMOVED) {
+                    original[changes.renumbered_vertices[vertex]] = vertex;
+                }
+            }
+        }
+        auto const removed = [renumbering](std::size_t vertex) { return renumbering[vertex] == REMOVED; };
+        for (auto const &face : changes.deleted_faces) {
+            if (std::any_of(face.begin(), face.end(), removed)) {
+                changes.removed_faces.push_back(
+                    canonical_face(original[face[0]], original[face[1]], original[face[2]]));
+            }
+        }
+        for (auto const &edge : changes.deleted_edges) {
+            if (removed(edge[0]) || removed(edge[1])) {
+                changes.removed_edges.push_back(
+                    {std::min(original[edge[0]], original[edge[1]]), std::max(original[edge[0]], original[edge[1]])});
+            }
+        }
+        sort_unique(changes.removed_faces);
+        sort_unique(changes.removed_edges);
+
+        for (auto *list : {&changes.created_faces, &changes.deleted_faces}) {
+            for (auto &face : *list) {
+                face = canonical_face(renumber(face[0]), renumber(face[1]), renumber(face[2]));
+            }
+            std::erase_if(*list, [](face_t const &face) {
+                return face[0] == face[1] || face[1] == face[2] || face[2] == face[0] ||
+                       std::find(face.begin(), face.end(), REMOVED) != face.end();
+            });
+            sort_unique(*list);
+        }
+        for (auto *list : {&changes.created_edges, &changes.deleted_edges}) {
+            for (auto &edge : *list) {
+                edge = {std::min(renumber(edge[0]), renumber(edge[1])), std::max(renumber(edge[0]), renumber(edge[1]))};
+            }
+            std::erase_if(*list, [](edge_t const &edge) { return edge[0] == edge[1] || edge[1] == REMOVED; });
+            sort_unique(*list);
+        }
+        for (auto *list : {&changes.dirty_vertices, &touched_vertices, &moved_vertices}) {
+            for (std::size_t &vertex : *list) {
+                vertex = renumber(vertex);
+            }
+            std::erase(*list, REMOVED);
+        }
+        sort_unique(changes.dirty_vertices);
+
+        // Faces of a removed vertex are gone
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i + 2 < previous_faces.size(); i += 3) {
+            std::array<std::size_t, 3> const face = {renumber(previous_faces[i]), renumber(previous_faces[i + 1]),
+                                                     renumber(previous_faces[i + 2])};
+            if (std::find(face.begin(), face.end(), REMOVED) == face.end()) {
+                std::copy(face.begin(), face.end(), previous_faces.begin() + static_cast<std::ptrdiff_t>(kept));
+                kept += 3;
+            }
+        }
+        previous_faces.resize(kept);
+
+        if (changes.renumbered_vertices.empty()) {
+            changes.renumbered_vertices.assign(renumbering.begin(), renumbering.end());
+        } else {
+            for (std::size_t &vertex : changes.renumbered_vertices) {
+                vertex = renumber(vertex);
+            }
+        }
+    }
+}// namespace delaunay
@@ -0,0 +1,427 @@
+#include "delaunay/concurrent_insertion.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace delaunay {
+    ConcurrentInsertion::ConcurrentInsertion(Delaunay &triangulation, std::size_t capacity) :
+        triangulation(triangulation),
+        base_count(triangulation.vertices.size()),
+        vertex_locks(base_count + capacity, triangulation.memory_resource()),
+        vertex_edges(base_count + capacity, triangulation.memory_resource()),
+        inserted(capacity, point_t(0, 0), triangulation.memory_resource()) {
+        for (QuadEdge *edge : triangulation.primary_edges) {
+            if (!edge->is_deleted()) {
+                vertex_edges[edge->origin_index()].store(edge, std::memory_order_relaxed);
+                vertex_edges[edge->destination_index()].store(edge->sym(), std::memory_order_relaxed);
+            }
+        }
+        if (triangulation.hull_edge != nullptr) {
+            last_vertex = triangulation.hull_edge->origin_index();
+        }
+    }
+
+    ConcurrentInsertion::~ConcurrentInsertion() {
+        finish();
+    }
+
+    auto ConcurrentInsertion::insert(point_t const &point) -> Result {
+        // Without triangles there is no inside
+        if (triangulation.faces.empty()) {
+            return Result::OUTSIDE_HULL;
+        }
+
+        // The buffers are reused by all inserts of a thread
+        thread_local Cavity cavity;
+        Result result = Result::INSERTED;
+        while (try_insert(point, cavity, result) == Attempt::CONFLICT) {
+            unlock(cavity);
+            std::this_thread::yield();
+        }
+        return result;
+    }
+
+    auto ConcurrentInsertion::find_triangle(point_t const &point) -> std::optional<std::array<std::size_t, 3>> {
+        if (triangulation.faces.empty()) {
+            return std::nullopt;
+        }
+
+        thread_local Cavity cavity;
+        std::optional<Result> result;
+        while (lock_start(point, cavity, result) == Attempt::CONFLICT) {
+            unlock(cavity);
+            std::this_thread::yield();
+        }
+
+        std::optional<std::array<std::size_t, 3>> triangle;
+        if (result != Result::OUTSIDE_HULL) {
+            QuadEdge *edge = cavity.triangles.front();
+            triangle = {edge->origin_index(), edge->destination_index(), left_face_next(edge)->destination_index()};
+        }
+        unlock(cavity);
+        return triangle;
+    }
+
+    void ConcurrentInsertion::get_neighbours(std::size_t vertex, std::vector<std::size_t> &neighbours) {
+        neighbours.clear();
+
+        // Readers wait for the vertex instead of retrying, they only hold one lock
+        std::uint32_t expected = 0;
+        while (!vertex_locks[vertex].compare_exchange_weak(expected, 1, std::memory_order_acquire)) {
+            expected = 0;
+            std::this_thread::yield();
+        }
+
+        QuadEdge *start = vertex_edges[vertex].load(std::memory_order_acquire);
+        if (start != nullptr) {
+            QuadEdge *edge = start;
+            do {
+                neighbours.push_back(edge->destination_index());
+                edge = orbit_next(edge);
+            } while (edge != start);
+        }
+        vertex_locks[vertex].store(0, std::memory_order_release);
+    }
+
+    auto ConcurrentInsertion::size() const -> std::size_t {
+        return inserted_count.load();
+    }
+
+    void ConcurrentInsertion::finish() {
+        if (finished) {
+            return;
+        }
+        finished = true;
+
+        std::size_t const count = inserted_count.load();
+        triangulation.vertices.insert(triangulation.vertices.end(), inserted.begin(),
+                                      inserted.begin() + static_cast<std::ptrdiff_t>(count));
+
+        // Snapshots have no input mapping
+        if (!triangulation.vertex_origins.empty()) {
+            for (std::size_t i = 0; i < count; i++) {
+                triangulation.vertex_origins.push_back(triangulation.input_vertices.size());
+                triangulation.input_vertices.push_back(base_count + i);
+            }
+        }
+        for (auto &channel : triangulation.vertex_attributes) {
+            channel->resize(triangulation.vertices.size());
+        }
+
+        // The faces changed only around the inserted vertices
+        if (triangulation.changes_tracked) {
+            for (std::size_t vertex = base_count; vertex < base_count + count; vertex++) {
+                QuadEdge *edge = vertex_edges[vertex].load();
+                QuadEdge *current = edge;
+                triangulation.touch_vertex(vertex);
+                do {
+                    triangulation.touch_vertex(current->destination_index());
+                    current = current->orbit_next();
+                } while (current != edge);
+            }
+        }
+
+        if (count > 0) {
+            triangulation.update_vornoi_graph();
+        }
+    }
+
+    auto ConcurrentInsertion::try_insert(point_t const &point, Cavity &cavity, Result &result) -> Attempt {
+        std::optional<Result> early;
+        if (lock_start(point, cavity, early) == Attempt::CONFLICT) {
+            return Attempt::CONFLICT;
+        }
+        if (early.has_value()) {
+            result = *early;
+            unlock(cavity);
+            return Attempt::DONE;
+        }
+
+        auto contains = [&cavity](QuadEdge *edge) {
+            return std::any_of(cavity.triangles.begin(), cavity.triangles.end(), [edge](QuadEdge *triangle) {
+                return triangle == edge || left_face_next(triangle) == edge ||
+                       left_face_next(left_face_next(triangle)) == edge;
+            });
+        };
+
+        // Grow the cavity over the edges of its triangles. A triangle next to the cavity cannot change,
+        // as the two vertices it shares with the cavity are locked, only its third vertex needs a lock.
+        while (!cavity.pending.empty()) {
+            QuadEdge *edge = cavity.pending.back();
+            cavity.pending.pop_back();
+
+            QuadEdge *neighbour = edge->sym();
+            if (!is_triangle(neighbour) || contains(neighbour)) {
+                continue;
+            }
+
+            // The cavity must be star shaped around the point, the inexact predicates may disagree
+            QuadEdge *next = left_face_next(neighbour);
+            if (!point_t::in_circle(neighbour->origin(), neighbour->destination(), next->destination(), point) &&
+                point_t::counter_clock_wise(edge->origin(), edge->destination(), point)) {
+                continue;
+            }
+
+            if (!try_lock(next->destination_index(), cavity)) {
+                return Attempt::CONFLICT;
+            }
+            cavity.triangles.push_back(neighbour);
+            cavity.pending.push_back(next);
+            cavity.pending.push_back(left_face_next(next));
+        }
+
+        for (QuadEdge *triangle : cavity.triangles) {
+            for (QuadEdge *edge : {triangle, left_face_next(triangle), left_face_next(left_face_next(triangle))}) {
+                QuadEdge *neighbour = edge->sym();
+                if (is_triangle(neighbour) && contains(neighbour)) {
+                    continue;
+                }
+
+                // Only hull edges can be boundary edges the point is not left of
+                if (!point_t::counter_clock_wise(edge->origin(), edge->destination(), point)) {
+                    result = Result::OUTSIDE_HULL;
+                    unlock(cavity);
+                    return Attempt::DONE;
+                }
+                cavity.boundary.push_back(edge);
+            }
+        }
+
+        // A disk of t triangles without inner vertices has t + 2 boundary edges
+        if (cavity.boundary.size() != cavity.triangles.size() + 2) {
+            result = Result::DEGENERATE;
+            unlock(cavity);
+            return Attempt::DONE;
+        }
+
+        std::size_t slot = inserted_count.load();
+        do {
+            if (slot == inserted.size()) {
+                unlock(cavity);
+                throw std::runtime_error("Insertion capacity exhausted");
+            }
+        } while (!inserted_count.compare_exchange_weak(slot, slot + 1));
+
+        std::size_t const vertex = base_count + slot;
+        inserted[slot] = point;
+        vertex_locks[vertex].store(1, std::memory_order_relaxed);
+        cavity.locked.push_back(vertex);
+
+        fill_cavity(point, vertex, cavity);
+        last_vertex.store(vertex, std::memory_order_relaxed);
+
+        result = Result::INSERTED;
+        unlock(cavity);
+        return Attempt::DONE;
+    }
+
+    auto ConcurrentInsertion::walk(point_t const &point) -> std::optional<WalkResult> {
+        QuadEdge *edge = vertex_edges[last_vertex.load(std::memory_order_relaxed)].load(std::memory_order_acquire);
+        if (edge == nullptr) {
+            return std::nullopt;
+        }
+        if (!is_triangle(edge)) {
+            edge = edge->sym();
+        }
+
+        // A walk through a valid triangulation visits every triangle at most once. There are about twice as
+        // many triangles as vertices, every insert adds two
+        std::size_t const limit =
+            triangulation.face_edges.size() + 2 * inserted_count.load(std::memory_order_relaxed) + 64;
+        for (std::size_t step = 0; step < limit; step++) {
+            if (!is_triangle(edge)) {
+                return std::nullopt;
+            }
+            QuadEdge *second = left_face_next(edge);
+            QuadEdge *third = left_face_next(second);
+
+            // Cross the first edge the point is right of, starting at a different edge every step
+            QuadEdge *sides[] = {edge, second, third};
+            bool moved = false;
+            for (std::size_t i = 0; i < 3 && !moved; i++) {
+                QuadEdge *side = sides[(i + step) % 3];
+                if (point_t::counter_clock_wise(side->destination(), side->origin(), point)) {
+                    if (!is_triangle(side->sym())) {
+                        return WalkResult{side, true};
+                    }
+                    edge = side->sym();
+                    moved = true;
+                }
+            }
+            if (!moved) {
+                return WalkResult{edge, false};
+            }
+        }
+        return std::nullopt;
+    }
+
+    auto ConcurrentInsertion::lock_start(point_t const &point, Cavity &cavity, std::optional<Result> &result)
+        -> Attempt {
+        cavity.locked.clear();
+        cavity.triangles.clear();
+        cavity.boundary.clear();
+        cavity.pending.clear();
+        result.reset();
+
+        auto const walked = walk(point);
+        if (!walked.has_value()) {
+            return Attempt::CONFLICT;
+        }
+
+        QuadEdge *edge = walked->edge;
+        if (!try_lock(edge->origin_index(), cavity) || !try_lock(edge->destination_index(), cavity) ||
+            edge->state == EdgeState::DELETED) {
+            return Attempt::CONFLICT;
+        }
+
+        // Hull edges never change, the walk only has to be confirmed
+        if (walked->outside) {
+            if (is_triangle(edge) && !is_triangle(edge->sym()) &&
+                point_t::counter_clock_wise(edge->destination(), edge->origin(), point)) {
+                result = Result::OUTSIDE_HULL;
+                return Attempt::DONE;
+            }
+            return Attempt::CONFLICT;
+        }
+
+        QuadEdge *second = left_face_next(edge);
+        if (!try_lock(second->destination_index(), cavity) || !is_triangle(edge)) {
+            return Attempt::CONFLICT;
+        }
+
+        // The triangle is locked now, the point must still be inside (or on its boundary)
+        QuadEdge *third = left_face_next(second);
+        for (QuadEdge *side : {edge, second, third}) {
+            if (point_t::counter_clock_wise(side->destination(), side->origin(), point)) {
+                return Attempt::CONFLICT;
+            }
+        }
+
+        cavity.triangles.push_back(edge);
+        cavity.pending.insert(cavity.pending.end(), {edge, second, third});
+        if (point == edge->origin() || point == second->origin() || point == third->origin()) {
+            result = Result::DUPLICATE;
+        }
+        return Attempt::DONE;
+    }
+
+    auto ConcurrentInsertion::try_lock(std::size_t vertex, Cavity &cavity) -> bool {
+        if (std::find(cavity.locked.begin(), cavity.locked.end(), vertex) != cavity.locked.end()) {
+            return true;
+        }
+
+        std::uint32_t expected = 0;
+        if (!vertex_locks[vertex].compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
+            return false;
+        }
+        cavity.locked.push_back(vertex);
+        return true;
+    }
+
+    void ConcurrentInsertion::unlock(Cavity &cavity) {
+        for (std::size_t vertex : cavity.locked) {
+            vertex_locks[vertex].store(0, std::memory_order_release);
+        }
+        cavity.locked.clear();
+    }
+
+    void ConcurrentInsertion::fill_cavity(point_t const &point, std::size_t vertex, Cavity &cavity) {
+        // Edges between two cavity triangles, collected before the triangles fall apart
+        auto &inner = cavity.pending;
+        for (QuadEdge *triangle : cavity.triangles) {
+            for (QuadEdge *edge : {triangle, left_face_next(triangle), left_face_next(left_face_next(triangle))}) {
+                if (std::find(cavity.boundary.begin(), cavity.boundary.end(), edge) == cavity.boundary.end() &&
+                    edge < edge->sym()) {
+                    inner.push_back(edge);
+                }
+            }
+        }
+
+        // The dual quarter edges are retired too, so they do not keep the circumcenters of the old triangles.
+        // Walks only follow their rot links, which stay
+        point_t const infinity(std::numeric_limits<scalar_t>::infinity(), std::numeric_limits<scalar_t>::infinity());
+        for (QuadEdge *edge : inner) {
+            splice_edges(edge, orbit_prev(edge));
+            splice_edges(edge->sym(), orbit_prev(edge->sym()));
+            edge->state = EdgeState::DELETED;
+            edge->sym()->state = EdgeState::DELETED;
+            for (QuadEdge *dual : {edge->p_rot, edge->sym()->p_rot}) {
+                dual->m_origin = infinity;
+                dual->m_origin_index = QuadEdge::INVALID_INDEX;
+                dual->state = EdgeState::DELETED;
+            }
+        }
+
+        // One edge from every boundary vertex to the new vertex, the origins are set below
+        auto &spokes = cavity.spokes;
+        spokes.resize(cavity.boundary.size());
+        {
+            std::lock_guard const lock(edge_mutex);
+            for (QuadEdge *&spoke : spokes) {
+                spoke = triangulation.make_edge(point, vertex, point, vertex);
+            }
+        }
+
+        // Fan around the new vertex, as InsertSite from Guibas and Stolfi.
+        // A spoke is only published by its splice, so its origin can still be written plainly.
+        QuadEdge *boundary = cavity.boundary.front();
+        QuadEdge *base = spokes.front();
+        base->m_origin = boundary->origin();
+        base->m_origin_index = boundary->origin_index();
+        splice_edges(base, boundary);
+
+        QuadEdge *first = base;
+        for (std::size_t i = 1; i < spokes.size(); i++) {
+            // Connect from the destination of the boundary edge to the new vertex
+            QuadEdge *spoke = spokes[i];
+            spoke->m_origin = boundary->destination();
+            spoke->m_origin_index = boundary->destination_index();
+            splice_edges(spoke, left_face_next(boundary));
+            splice_edges(spoke->sym(), base->sym());
+
+            base = spoke;
+            boundary = orbit_prev(base);
+        }
+
+        for (QuadEdge *edge : cavity.boundary) {
+            vertex_edges[edge->origin_index()].store(edge, std::memory_order_release);
+        }
+        vertex_edges[vertex].store(first->sym(), std::memory_order_release);
+    }
+
+    void ConcurrentInsertion::splice_edges(QuadEdge *a, QuadEdge *b) {
+        QuadEdge *alpha = orbit_next(a)->p_rot;
+        QuadEdge *beta = orbit_next(b)->p_rot;
+
+        QuadEdge *a_onext = orbit_next(a);
+        QuadEdge *b_onext = orbit_next(b);
+        QuadEdge *alpha_onext = orbit_next(alpha);
+        QuadEdge *beta_onext = orbit_next(beta);
+
+        std::atomic_ref(a->p_onext).store(b_onext, std::memory_order_release);
+        std::atomic_ref(b->p_onext).store(a_onext, std::memory_order_release);
+        std::atomic_ref(alpha->p_onext).store(beta_onext, std::memory_order_release);
+        std::atomic_ref(beta->p_onext).store(alpha_onext, std::memory_order_release);
+    }
+
+    auto ConcurrentInsertion::orbit_next(QuadEdge *edge) -> QuadEdge * {
+        return std::atomic_ref(edge->p_onext).load(std::memory_order_acquire);
+    }
+
+    auto ConcurrentInsertion::orbit_prev(QuadEdge *edge) -> QuadEdge * {
+        return orbit_next(edge->p_rot)->p_rot;
+    }
+
+    auto ConcurrentInsertion::left_face_next(QuadEdge *edge) -> QuadEdge * {
+        return orbit_next(edge->p_rot->p_rot->p_rot)->p_rot;
+    }
+
+    auto ConcurrentInsertion::is_triangle(QuadEdge *edge) -> bool {
+        QuadEdge *second = left_face_next(edge);
+        QuadEdge *third = left_face_next(second);
+        return left_face_next(third) == edge &&
+               point_t::counter_clock_wise(edge->origin(), edge->destination(), second->destination());
+    }
+}// namespace delaunay
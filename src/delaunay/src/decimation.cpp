@@ -0,0 +1,280 @@
+#include "delaunay/decimation.hpp"
+#include "hole_triangulation.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+namespace delaunay {
+    namespace {
+        /**
+         * Min-heap order on the error
+         */
+        auto heap_order(std::pair<scalar_t, std::size_t> const &a, std::pair<scalar_t, std::size_t> const &b)
+            -> bool {
+            return a.first > b.first;
+        }
+    }// namespace
+
+    Decimation::Decimation(Delaunay &triangulation, std::string_view height_attribute) :
+        triangulation(triangulation),
+        height_attribute(height_attribute) {
+        // Fails early if there is no such attribute
+        std::ignore = triangulation.get_vertex_attribute<scalar_t>(height_attribute);
+
+        // The origins are a channel, so they follow every renumbering, also the rebuilds of remove_vertices()
+        auto const inputs = triangulation.get_input_vertices();
+        std::vector<std::size_t> values(inputs.begin(), inputs.end());
+        if (values.empty()) {
+            values.resize(triangulation.get_vertices().size());
+            std::iota(values.begin(), values.end(), 0);
+        }
+        triangulation.add_vertex_attribute<std::size_t>(ORIGINS_ATTRIBUTE, values);
+        compute_errors();
+    }
+
+    Decimation::~Decimation() {
+        compact();
+        triangulation.remove_vertex_attribute(ORIGINS_ATTRIBUTE);
+    }
+
+    auto Decimation::step(std::size_t target_vertices, scalar_t error_bound) -> std::size_t {
+        // Removed vertices stay in the triangulation until compact()
+        std::size_t const vertex_count =
+            triangulation.get_vertices().size() - triangulation.get_detached_vertices().size();
+        if (vertex_count <= target_vertices || triangulation.get_faces().empty()) {
+            return 0;
+        }
+
+        // Greedy independent set in the order of the errors: a removed vertex claims itself and its neighbours,
+        // the candidates a claim blocks wait for the next step. Claims are marked with the step, so the marks
+        // of earlier steps need not be cleared. Once the blocked candidates outnumber the removed ones the step ends,
+        // popping past them would only queue them again
+        claims.resize(triangulation.get_vertices().size(), 0);
+        std::size_t const claim = ++steps;
+        std::vector<std::size_t> removed;
+        std::vector<std::size_t> deferred;
+        std::size_t const budget = vertex_count - target_vertices;
+        while (removed.size() < budget && deferred.size() <= removed.size() + 64 && !candidates.empty() &&
+               candidates.front().first <= error_bound) {
+            std::pop_heap(candidates.begin(), candidates.end(), heap_order);
+            auto const [error, origin] = candidates.back();
+            candidates.pop_back();
+
+            // Lazy deletion, removed vertices and outdated errors are skipped
+            if (vertex_edges[origin] == nullptr || errors[origin] != error) {
+                continue;
+            }
+            queued[origin] = 0;
+
+            QuadEdge *edge = vertex_edges[origin];
+            bool free = claims[edge->origin_index()] != claim;
+            QuadEdge *current = edge;
+            do {
+                free = free && claims[current->destination_index()] != claim;
+                current = current->orbit_next();
+            } while (free && current != edge);
+            if (!free) {
+                deferred.push_back(origin);
+                continue;
+            }
+
+            claims[edge->origin_index()] = claim;
+            do {
+                claims[current->destination_index()] = claim;
+                current = current->orbit_next();
+            } while (current != edge);
+            removed.push_back(origin);
+            max_error = std::max(max_error, error);
+        }
+        if (removed.empty()) {
+            for (std::size_t origin : deferred) {
+                enqueue(origin);
+            }
+            return 0;
+        }
+
+        // Only the vertices around the holes get new neighbours, the edges between them stay
+        auto const origins = get_origins();
+        std::vector<QuadEdge *> leaving;
+        std::vector<std::pair<std::size_t, QuadEdge *>> ring;
+        leaving.reserve(removed.size());
+        for (std::size_t origin : removed) {
+            QuadEdge *edge = vertex_edges[origin];
+            QuadEdge *current = edge;
+            do {
+                ring.emplace_back(origins[current->destination_index()], current->left_face_next());
+                current = current->orbit_next();
+            } while (current != edge);
+            leaving.push_back(edge);
+            vertex_edges[origin] = nullptr;
+        }
+
+        // After flips or a rebuild the changes are not local, all candidates are found again
+        if (!triangulation.detach_vertices(leaving)) {
+            compute_errors();
+            return removed.size();
+        }
+
+        std::span<scalar_t const> const heights = triangulation.get_vertex_attribute<scalar_t>(height_attribute);
+        std::vector<scalar_t> ring_errors(ring.size());
+        parallel::parallel_for(ring.size(), [&](std::size_t begin, std::size_t end) {
+            std::pmr::vector<point_t> polygon;
+            std::vector<scalar_t> polygon_heights;
+            std::pmr::vector<std::size_t> ring_buffer;
+            std::pmr::vector<std::array<std::size_t, 3>> ears;
+            for (std::size_t i = begin; i < end; i++) {
+                ring_errors[i] = vertex_error(ring[i].second, heights, polygon, polygon_heights, ring_buffer, ears);
+            }
+        });
+        // Entries of the ring vertices are outdated, the other blocked candidates are queued again unchanged
+        for (std::size_t i = 0; i < ring.size(); i++) {
+            auto const [origin, edge] = ring[i];
+            vertex_edges[origin] = edge;
+            errors[origin] = ring_errors[i];
+            queued[origin] = 0;
+            enqueue(origin);
+        }
+        for (std::size_t origin : deferred) {
+            enqueue(origin);
+        }
+        return removed.size();
+    }
+
+    auto Decimation::decimate(std::size_t target_vertices, scalar_t error_bound) -> std::size_t {
+        while (step(target_vertices, error_bound) > 0) {
+        }
+        compact();
+        return triangulation.get_vertices().size();
+    }
+
+    void Decimation::compact() {
+        // The edges stay where they are, so vertex_edges and the candidates stay valid
+        triangulation.compact_vertices();
+    }
+
+    auto Decimation::progressive(std::span<std::size_t const> vertex_counts, scalar_t error_bound)
+        -> std::vector<Level> {
+        std::vector<Level> levels;
+        levels.reserve(vertex_counts.size());
+        for (std::size_t count : vertex_counts) {
+            decimate(count, error_bound);
+
+            auto const &vertices = triangulation.get_vertices();
+            auto const &faces = triangulation.get_faces();
+            auto const heights = triangulation.get_vertex_attribute<scalar_t>(height_attribute);
+            auto const origins = get_origins();
+            levels.push_back({{vertices.begin(), vertices.end()},
+                              {heights.begin(), heights.end()},
+                              {faces.begin(), faces.end()},
+                              {origins.begin(), origins.end()},
+                              max_error});
+        }
+        return levels;
+    }
+
+    auto Decimation::get_origins() const -> std::span<std::size_t const> {
+        return triangulation.get_vertex_attribute<std::size_t>(ORIGINS_ATTRIBUTE);
+    }
+
+    auto Decimation::get_max_error() const -> scalar_t {
+        return max_error;
+    }
+
+    void Decimation::compute_errors() {
+        auto const origins = get_origins();
+        std::span<scalar_t const> const heights = triangulation.get_vertex_attribute<scalar_t>(height_attribute);
+
+        // Removed vertices are no origin of a remaining one, so they keep no edge
+        std::size_t const origin_count = vertex_edges.empty() ? origins.size() : vertex_edges.size();
+        vertex_edges.assign(origin_count, nullptr);
+        for (QuadEdge *edge : triangulation.get_primary_edges()) {
+            if (!edge->is_deleted()) {
+                vertex_edges[origins[edge->origin_index()]] = edge;
+                vertex_edges[origins[edge->destination_index()]] = edge->sym();
+            }
+        }
+
+        errors.assign(origin_count, std::numeric_limits<scalar_t>::infinity());
+        parallel::parallel_for(origin_count, [&](std::size_t begin, std::size_t end) {
+            std::pmr::vector<point_t> polygon;
+            std::vector<scalar_t> polygon_heights;
+            std::pmr::vector<std::size_t> ring;
+            std::pmr::vector<std::array<std::size_t, 3>> ears;
+            for (std::size_t origin = begin; origin < end; origin++) {
+                if (vertex_edges[origin] != nullptr) {
+                    errors[origin] = vertex_error(vertex_edges[origin], heights, polygon, polygon_heights, ring, ears);
+                }
+            }
+        });
+
+        // Hull vertices and those without edges have infinite errors, even an infinite bound keeps them
+        candidates.clear();
+        queued.assign(origin_count, 0);
+        for (std::size_t origin = 0; origin < origin_count; origin++) {
+            if (std::isfinite(errors[origin])) {
+                candidates.emplace_back(errors[origin], origin);
+                queued[origin] = 1;
+            }
+        }
+        std::make_heap(candidates.begin(), candidates.end(), heap_order);
+    }
+
+    void Decimation::enqueue(std::size_t origin) {
+        if (queued[origin] == 0 && vertex_edges[origin] != nullptr && std::isfinite(errors[origin])) {
+            candidates.emplace_back(errors[origin], origin);
+            std::push_heap(candidates.begin(), candidates.end(), heap_order);
+            queued[origin] = 1;
+        }
+    }
+
+    auto Decimation::vertex_error(QuadEdge *edge, std::span<scalar_t const> heights,
+                                  std::pmr::vector<point_t> &polygon, std::vector<scalar_t> &polygon_heights,
+                                  std::pmr::vector<std::size_t> &ring,
+                                  std::pmr::vector<std::array<std::size_t, 3>> &ears) -> scalar_t {
+        polygon.clear();
+        polygon_heights.clear();
+        QuadEdge *current = edge;
+        do {
+            if (current->left_face_index() == QuadEdge::INVALID_INDEX) {
+                return std::numeric_limits<scalar_t>::infinity();
+            }
+            polygon.push_back(current->destination());
+            polygon_heights.push_back(heights[current->destination_index()]);
+            current = current->orbit_next();
+        } while (current != edge);
+
+        std::ignore = triangulate_hole(polygon, ring, ears);
+
+        // The vertex lies in the ear whose smallest barycentric coordinate is largest, which also
+        // picks the nearest ear where rounding puts it just outside all of them
+        point_t const &p = edge->origin();
+        auto cross = [](point_t const &a, point_t const &b, point_t const &c) {
+            return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        };
+        scalar_t best_weight = -std::numeric_limits<scalar_t>::infinity();
+        scalar_t interpolated = 0;
+        for (auto const &[i, j, k] : ears) {
+            scalar_t const area = cross(polygon[i], polygon[j], polygon[k]);
+            if (area <= 0) {
+                continue;
+            }
+            scalar_t const u = cross(p, polygon[j], polygon[k]) / area;
+            scalar_t const v = cross(p, polygon[k], polygon[i]) / area;
+            scalar_t const w = 1 - u - v;
+            scalar_t const weight = std::min({u, v, w});
+            if (weight > best_weight) {
+                best_weight = weight;
+                interpolated = u * polygon_heights[i] + v * polygon_heights[j] + w * polygon_heights[k];
+            }
+        }
+        if (best_weight == -std::numeric_limits<scalar_t>::infinity()) {
+            return std::numeric_limits<scalar_t>::infinity();
+        }
+        return std::abs(interpolated - heights[edge->origin_index()]);
+    }
+}// namespace delaunay
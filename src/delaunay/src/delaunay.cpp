@@ -1,50 +1,154 @@
 #include "delaunay/delaunay.hpp"
 #include "delaunay/quad_edge.hpp"
+#include "parallel.hpp"
 
 #include <algorithm>
 #include <cmath>
-#include <stack>
+#include <limits>
+#include <numeric>
+#include <tuple>
 
 namespace delaunay {
-    auto Delaunay::triangulate(std::vector<point_t> &points) -> delaunay::Delaunay {
-        return Delaunay(points);
+    namespace {
+        /**
+         * Number of leaves merged up to one hull before the next leaves are touched.
+         * Merging a level across the whole input at once would sweep all edges once per level.
+         */
+        constexpr std::size_t MERGE_TILE_SIZE = 2048;
+    }// namespace
+
+    auto Delaunay::triangulate(std::vector<point_t> &points, std::pmr::memory_resource *resource)
+        -> delaunay::Delaunay {
+        return Delaunay(points, resource);
     }
 
-    Delaunay::Delaunay(std::vector<point_t> &points) {
+    auto Delaunay::triangulate(std::span<point_t const> points, std::pmr::memory_resource *resource)
+        -> delaunay::Delaunay {
+        return Delaunay(points, resource);
+    }
+
+    Delaunay::Delaunay(std::pmr::memory_resource *resource) :
+        vertices(resource),
+        vertex_origins(resource),
+        input_vertices(resource),
+        detached_vertices(resource),
+        hull_edge(nullptr),
+        faces(resource),
+        face_edges(resource),
+        circumcenters(resource),
+        face_areas(resource),
+        vertex_attributes(resource),
+        edge_pool(resource),
+        primary_edges(resource),
+        primary_sym_edges(resource),
+        dual_edges(resource),
+        dual_sym_edges(resource),
+        changes(resource),
+        previous_faces(resource),
+        touched_vertices(resource),
+        moved_vertices(resource) {}
+
+    Delaunay::Delaunay(std::vector<point_t> &points, std::pmr::memory_resource *resource) : Delaunay(resource) {
         // Triangulation requires at least 3 Points
         if (points.size() < 3) {
             return;
         }
 
-        // Sort points, as this is important for the divide and concquer algorithm to work
-        std::stable_sort(points.begin(), points.end(), [](point_t const &a, point_t const &b) {
-            return a.y > b.y;
-        });
+        set_vertices(points);
+
+        // The callers points are sorted and without duplicates afterwards
+        points.assign(vertices.begin(), vertices.end());
+
+        build();
+    }
 
-        std::stable_sort(points.begin(), points.end(), [](point_t const &a, point_t const &b) {
-            return a.x > b.x;
+    Delaunay::Delaunay(std::span<point_t const> points, std::pmr::memory_resource *resource) : Delaunay(resource) {
+        // Triangulation requires at least 3 Points
+        if (points.size() < 3) {
+            return;
+        }
+
+        set_vertices(points);
+        build();
+    }
+
+    auto Delaunay::memory_resource() const -> std::pmr::memory_resource * {
+        return vertices.get_allocator().resource();
+    }
+
+    void Delaunay::set_vertices(std::span<point_t const> points) {
+        // Sort an index permutation instead of the points, as this is important for the divide and concquer
+        // algorithm to work. Equal points keep their input order, so the first one of them becomes the vertex.
+        std::pmr::vector<std::size_t> order(points.size(), memory_resource());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        parallel::sort(order.begin(), order.end(), [points](std::size_t a, std::size_t b) {
+            if (points[a].x != points[b].x) {
+                return points[a].x > points[b].x;
+            }
+            if (points[a].y != points[b].y) {
+                return points[a].y > points[b].y;
+            }
+            return a < b;
         });
 
         // Remove duplicates, as they destroy the triangulation
-        auto last = std::unique(points.begin(), points.end());
-        points.erase(last, points.end());
+        vertices.clear();
+        vertex_origins.clear();
+        input_vertices.resize(points.size());
+        for (std::size_t index : order) {
+            if (vertices.empty() || !(vertices.back() == points[index])) {
+                vertices.push_back(points[index]);
+                vertex_origins.push_back(index);
+            }
+            input_vertices[index] = vertices.size() - 1;
+        }
+    }
 
-        // Call recursive triangulation routine
-        auto result = delaunay_divide_and_conquer(points, 0, points.size());
+    void Delaunay::build() {
+        if (vertices.size() < 2 || is_cancelled()) {
+            return;
+        }
+
+        // Triangulate bottom up, keeping an edge of the convex hull
+        hull_edge = delaunay_divide_and_conquer(vertices).first;
+        if (is_cancelled()) {
+            return;
+        }
 
-        // Create Vornoi Graph (starting at the right most edge
-        calculate_vornoi_graph(result.first);
+        // Create Vornoi Graph
+        calculate_vornoi_graph();
     }
 
+    auto Delaunay::is_cancelled() const -> bool {
+        return cancel_flag != nullptr && cancel_flag->load(std::memory_order_relaxed);
+    }
 
-    auto Delaunay::build_triangle(std::size_t start, std::vector<point_t> const &points)
+    void Delaunay::clear() {
+        vertices.clear();
+        vertex_origins.clear();
+        input_vertices.clear();
+        detached_vertices.clear();
+        hull_edge = nullptr;
+        faces.clear();
+        face_edges.clear();
+        circumcenters.clear();
+        face_areas.clear();
+        primary_edges.clear();
+        primary_sym_edges.clear();
+        dual_edges.clear();
+        dual_sym_edges.clear();
+        edge_pool.clear();
+    }
+
+
+    auto Delaunay::build_triangle(std::size_t start, std::pmr::vector<point_t> const &points)
         -> std::pair<QuadEdge *, QuadEdge *> {
         auto const &p1 = points[start];
         auto const &p2 = points[start + 1];
         auto const &p3 = points[start + 2];
 
-        auto *a = make_edge(p1, p2);
-        auto *b = make_edge(p2, p3);
+        auto *a = make_edge(start, start + 1);
+        auto *b = make_edge(start + 1, start + 2);
         splice_edges(a->sym(), b);
 
         if (point_t::counter_clock_wise(p1, p2, p3)) {
@@ -139,104 +243,187 @@ namespace delaunay {
         return {ldi, rdi};
     }
 
-    auto
-    Delaunay::delaunay_divide_and_conquer(std::vector<point_t> const &points, std::size_t start, std::size_t length)
+    auto Delaunay::delaunay_divide_and_conquer(std::pmr::vector<point_t> const &points)
         -> std::pair<QuadEdge *, QuadEdge *> {
-        // Build a single edge out of 2 points
-        if (length == 2) {
-            auto *a = make_edge(points[start], points[start + 1]);
-            return {a, a->sym()};
+        // Leaves are triangles, and one or two single edges if the number of points is not divisible by three
+        std::size_t const count = points.size();
+        std::size_t const edge_leaves = count % 3 == 0 ? 0 : 3 - count % 3;
+        std::size_t const triangle_leaves = (count - 2 * edge_leaves) / 3;
+
+        // Build all leaves in one sweep over the points, so their edges are stored next to each other
+        std::pmr::vector<std::pair<QuadEdge *, QuadEdge *>> hulls(memory_resource());
+        hulls.reserve(triangle_leaves + edge_leaves);
+        for (std::size_t leaf = 0; leaf < triangle_leaves; leaf++) {
+            hulls.push_back(build_triangle(3 * leaf, points));
         }
-
-        // Build a triangle out of the three given points
-        if (length == 3) {
-            return build_triangle(start, points);
+        for (std::size_t start = 3 * triangle_leaves; start < count; start += 2) {
+            auto *edge = make_edge(start, start + 1);
+            hulls.emplace_back(edge, edge->sym());
         }
 
-        // Divide and CONQUER
-        std::uint8_t const off = length % 2 == 0 ? 0 : 1;// Adjust for uneven lengths of array
-        auto left = delaunay_divide_and_conquer(points, start, length / 2);
-        auto right = delaunay_divide_and_conquer(points, start + length / 2, length / 2 + off);
-
-        // Find lowest common tangent (lowest point) of both halves
-        auto lowest = compute_lowest_common_tangent(left.second, right.first);
+        // Merge the levels of one tile after another while its edges are in cache, then the levels above the tiles
+        std::size_t tiles = 0;
+        for (std::size_t first = 0; first < hulls.size(); first += MERGE_TILE_SIZE) {
+            hulls[tiles++] = merge_levels(hulls, first, std::min(first + MERGE_TILE_SIZE, hulls.size()));
+        }
+        return merge_levels(hulls, 0, tiles);
+    }
 
-        // Merge both halves
-        auto merge_result = merge(left.first, lowest.first, lowest.second, right.second);
+    auto Delaunay::merge_levels(std::pmr::vector<std::pair<QuadEdge *, QuadEdge *>> &hulls, std::size_t first,
+                                std::size_t last) -> std::pair<QuadEdge *, QuadEdge *> {
+        while (last - first > 1 && !is_cancelled()) {
+            // The result of a merge replaces the pair in place, a hull without neighbour moves up unchanged
+            std::size_t const merges = (last - first) / 2;
+            for (std::size_t i = 0; i < merges; i++) {
+                auto const left = hulls[first + 2 * i];
+                auto const right = hulls[first + 2 * i + 1];
+
+                // Find lowest common tangent (lowest point) of both halves
+                auto lowest = compute_lowest_common_tangent(left.second, right.first);
+                hulls[first + i] = merge(left.first, lowest.first, lowest.second, right.second);
+            }
 
-        // Return result
-        return merge_result;
+            if ((last - first) % 2 == 1) {
+                hulls[first + merges] = hulls[last - 1];
+                last = first + merges + 1;
+            } else {
+                last = first + merges;
+            }
+        }
+        return hulls[first];
     }
 
-    auto Delaunay::get_primary_edges() -> std::vector<QuadEdge *> const & {
+    auto Delaunay::get_primary_edges() -> std::span<QuadEdge * const> {
         return this->primary_edges;
     }
 
-    auto Delaunay::get_dual_edges() -> std::vector<QuadEdge *> const & {
+    auto Delaunay::get_dual_edges() -> std::span<QuadEdge * const> {
         return this->dual_edges;
     }
 
-    void Delaunay::calculate_vornoi_graph(QuadEdge *start) {
-        if (start == nullptr) {
-            return;
-        }
+    auto Delaunay::get_vertices() -> std::span<point_t const> {
+        return this->vertices;
+    }
 
-        std::stack<QuadEdge *> edges_to_visit;
-        edges_to_visit.push(start);
+    auto Delaunay::get_vertex_origins() -> std::span<std::size_t const> {
+        return this->vertex_origins;
+    }
 
-        while (!edges_to_visit.empty()) {
-            QuadEdge *current = edges_to_visit.top();
-            edges_to_visit.pop();
+    auto Delaunay::get_input_vertices() -> std::span<std::size_t const> {
+        return this->input_vertices;
+    }
 
-            QuadEdge *a = current;
-            QuadEdge *b = current->left_face_next();
-            QuadEdge *c = current->left_face_next()->left_face_next();
+    auto Delaunay::get_faces() -> std::span<std::size_t const> {
+        return this->faces;
+    }
 
-            // If one of the edges was already visited, we don't want to create a triangle here as there already is one
-            if (a->state == EdgeState::INITIALIZED && b->state == EdgeState::INITIALIZED &&
-                c->state == EdgeState::INITIALIZED) {
-                if (point_t::counter_clock_wise(a->origin(), b->origin(), c->origin())) {
-                    point_t const circumcenter = point_t::circumcenter(a->origin(), b->origin(), c->origin());
+    auto Delaunay::get_face_edges() -> std::span<QuadEdge * const> {
+        return this->face_edges;
+    }
 
-                    a->inv_rot()->m_origin = circumcenter;
-                    b->inv_rot()->m_origin = circumcenter;
-                    c->inv_rot()->m_origin = circumcenter;
+    auto Delaunay::get_circumcenters() -> std::span<point_t const> {
+        return this->circumcenters;
+    }
 
-                    a->inv_rot()->state = EdgeState::INITIALIZED;
-                    b->inv_rot()->state = EdgeState::INITIALIZED;
-                    c->inv_rot()->state = EdgeState::INITIALIZED;
-                }
-            }
+    auto Delaunay::get_convex_hull() -> std::vector<QuadEdge *> {
+        std::vector<QuadEdge *> hull;
+        if (hull_edge == nullptr) {
+            return hull;
+        }
 
-            // Mark current Edge as already visited
-            current->state = EdgeState::PROCESSED;
-            current->sym()->state = EdgeState::PROCESSED;
+        // The hull edge has the triangulation on its left, so the outer face is on the left of its sym.
+        // Walking the outer face visits the hull clockwise.
+        QuadEdge *current = hull_edge->sym();
+        do {
+            hull.push_back(current->sym());
+            current = current->left_face_next();
+        } while (current != hull_edge->sym());
 
-            // The edges a and b are chosen is such a way, that their left face is
-            // not the same face as the triangle we just generated.
+        std::reverse(hull.begin(), hull.end());
+        return hull;
+    }
 
-            // Edge of upper adjacent triangle pointing in counterclockwise direction of the next triangle
-            QuadEdge *next_a = current->left_face_next()->sym();
-            if (next_a->state == EdgeState::INITIALIZED) {
-                edges_to_visit.push(next_a);
+    void Delaunay::assign_face_ids(std::pmr::vector<QuadEdge *> const &edges) {
+        for (QuadEdge *edge : edges) {
+            // Skip deleted edges, the outer face and faces that already have an id
+            if (edge->state == EdgeState::DELETED || edge->left_face_index() != QuadEdge::INVALID_INDEX ||
+                !edge->is_left_face_triangle()) {
+                continue;
             }
 
-            // Edge of lower adjacent triangle pointing in counterclockwise direction of the next triangle
-            QuadEdge *next_b = current->orbit_next();
-            if (next_b->state == EdgeState::INITIALIZED) {
-                edges_to_visit.push(next_b);
+            std::size_t const face = face_edges.size();
+            face_edges.push_back(edge);
+
+            QuadEdge *current = edge;
+            for (int i = 0; i < 3; i++) {
+                current->inv_rot()->m_origin_index = face;
+                faces.push_back(current->origin_index());
+                current = current->left_face_next();
             }
         }
     }
 
+    void Delaunay::calculate_vornoi_graph() {
+        faces.clear();
+        face_edges.clear();
+        face_areas.clear();
+
+        // Give every triangle an id, looking at both directions of every edge
+        assign_face_ids(primary_edges);
+        assign_face_ids(primary_sym_edges);
+
+        // Circumcenters are independent per triangle, so they are computed in parallel into a flat array
+        std::size_t const face_count = face_edges.size();
+        circumcenters.assign(face_count, point_t(0, 0));
+        parallel::parallel_for(face_count, [this](std::size_t begin, std::size_t end) {
+            std::size_t const *face = faces.data();
+            point_t const *points = vertices.data();
+            point_t *result = circumcenters.data();
+
+            for (std::size_t i = begin; i < end; i++) {
+                result[i] = point_t::circumcenter(points[face[3 * i]], points[face[3 * i + 1]], points[face[3 * i + 2]]);
+            }
+        });
+
+        // Fill the dual edges from the flat array, every quarter edge is written by exactly one thread
+        parallel::parallel_for(primary_edges.size(), [this](std::size_t begin, std::size_t end) {
+            point_t const infinity(std::numeric_limits<scalar_t>::infinity(), std::numeric_limits<scalar_t>::infinity());
+            for (std::size_t i = begin; i < end; i++) {
+                for (QuadEdge *edge : {primary_edges[i], primary_sym_edges[i]}) {
+                    // The dual edge eRot⁻¹ points out of the left face of e. Without a face (outer face or deleted
+                    // edge) it is reset to how make_edge() created it, so no circumcenter of a former face is kept
+                    QuadEdge *dual = edge->inv_rot();
+                    if (edge->state == EdgeState::DELETED || dual->m_origin_index == QuadEdge::INVALID_INDEX) {
+                        dual->m_origin = infinity;
+                        dual->m_origin_index = QuadEdge::INVALID_INDEX;
+                        dual->state = EdgeState::DELETED;
+                    } else {
+                        dual->m_origin = circumcenters[dual->m_origin_index];
+                        dual->state = EdgeState::INITIALIZED;
+                    }
+                    if (edge->state == EdgeState::DELETED) {
+                        continue;
+                    }
+
+                    // Mark edge as processed
+                    edge->state = EdgeState::PROCESSED;
+                }
+            }
+        });
+    }
+
+
+    auto Delaunay::make_edge(std::size_t origin, std::size_t destination) -> QuadEdge * {
+        return make_edge(vertices[origin], origin, vertices[destination], destination);
+    }
 
-    auto Delaunay::make_edge(point_t const &origin, point_t const &destination) -> QuadEdge * {
-        auto *primary = new QuadEdge(origin);
-        auto *dual =
-            new QuadEdge(point_t(std::numeric_limits<scalar_t>::infinity(), std::numeric_limits<scalar_t>::infinity()));
-        auto *primary_sym = new QuadEdge(destination);
-        auto *dual_sym =
-            new QuadEdge(point_t(std::numeric_limits<scalar_t>::infinity(), std::numeric_limits<scalar_t>::infinity()));
+    auto Delaunay::make_edge(point_t const &origin, std::size_t origin_index, point_t const &destination,
+                             std::size_t destination_index) -> QuadEdge * {
+        // The four quarter edges are stored next to each other in rot order
+        auto *primary = edge_pool.allocate(origin, origin_index, destination, destination_index);
+        auto *dual = primary + 1;
+        auto *primary_sym = primary + 2;
+        auto *dual_sym = primary + 3;
 
         // The primary edges have a set origin and destination
         primary->state = EdgeState::INITIALIZED;
@@ -252,6 +439,12 @@ namespace delaunay {
         primary_sym->p_rot = dual_sym;
         dual_sym->p_rot = primary;
 
+        std::size_t const id = 4 * primary_edges.size();
+        primary->m_id = id;
+        dual->m_id = id + 1;
+        primary_sym->m_id = id + 2;
+        dual_sym->m_id = id + 3;
+
         primary_edges.emplace_back(primary);
         dual_edges.emplace_back(dual);
         primary_sym_edges.emplace_back(primary_sym);
@@ -283,29 +476,11 @@ namespace delaunay {
     }
 
     auto Delaunay::connect_edges(QuadEdge *a, QuadEdge *b) -> QuadEdge * {
-        auto *new_edge = make_edge(a->destination(), b->origin());
+        auto *new_edge = make_edge(a->destination_index(), b->origin_index());
         splice_edges(new_edge, a->left_face_next());
         splice_edges(new_edge->sym(), b);
         return new_edge;
     }
 
-    Delaunay::~Delaunay() {
-        for (gsl::owner<QuadEdge *> edge : primary_edges) {
-            delete edge;
-        }
-        for (gsl::owner<QuadEdge *> edge : dual_edges) {
-            delete edge;
-        }
-        for (gsl::owner<QuadEdge *> edge : primary_sym_edges) {
-            delete edge;
-        }
-        for (gsl::owner<QuadEdge *> edge : dual_sym_edges) {
-            delete edge;
-        }
-
-        primary_edges.clear();
-        dual_edges.clear();
-        primary_sym_edges.clear();
-        dual_sym_edges.clear();
-    }
+    Delaunay::~Delaunay() = default;
 }// namespace analyser
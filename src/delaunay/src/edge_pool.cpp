@@ -0,0 +1,42 @@
+#include "delaunay/edge_pool.hpp"
+
+#include <limits>
+
+namespace delaunay {
+    EdgePool::EdgePool(std::pmr::memory_resource *resource) : blocks(resource) {}
+
+    auto EdgePool::allocate(point_t const &origin, std::size_t origin_index, point_t const &destination,
+                            std::size_t destination_index) -> QuadEdge * {
+        if (active_block < blocks.size() && blocks[active_block].size() == 4 * EDGES_PER_BLOCK) {
+            active_block++;
+        }
+        if (active_block == blocks.size()) {
+            // Blocks are constructed with the resource of the pool
+            blocks.emplace_back().reserve(4 * EDGES_PER_BLOCK);
+        }
+
+        point_t const infinity(std::numeric_limits<scalar_t>::infinity(), std::numeric_limits<scalar_t>::infinity());
+
+        // Never exceeds the reserved capacity, so the block is not reallocated
+        auto &block = blocks[active_block];
+        QuadEdge *primary = &block.emplace_back(origin, origin_index);
+        block.emplace_back(infinity, QuadEdge::INVALID_INDEX);
+        block.emplace_back(destination, destination_index);
+        block.emplace_back(infinity, QuadEdge::INVALID_INDEX);
+
+        edge_count++;
+        return primary;
+    }
+
+    void EdgePool::clear() {
+        for (auto &block : blocks) {
+            block.clear();
+        }
+        active_block = 0;
+        edge_count = 0;
+    }
+
+    auto EdgePool::size() const -> std::size_t {
+        return edge_count;
+    }
+}// namespace delaunay
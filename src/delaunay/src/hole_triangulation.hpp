@@ -0,0 +1,75 @@
+#ifndef DELAUNAY_HOLE_TRIANGULATION_HPP
+#define DELAUNAY_HOLE_TRIANGULATION_HPP
+
+#include "delaunay/point.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Triangulates the hole left by removing a vertex of a Delaunay triangulation by clipping ears.
+     * An ear whose circumcircle contains no other vertex of the hole is a Delaunay triangle, so these are clipped first.
+     * If the inexact predicates find none, an ear without hole vertices inside is clipped instead.
+     * @param polygon vertices of the hole, counter clockwise
+     * @param ring buffer for the remaining polygon
+     * @param ears receives the triangles as three positions in polygon (counter clockwise), in clipping order.
+     *             The last triangle is what remains of the polygon, the others were cut off by an edge
+     *             from their third to their first vertex.
+     * @return false if a clipped ear was not Delaunay
+     */
+    inline auto triangulate_hole(std::span<point_t const> polygon, std::pmr::vector<std::size_t> &ring,
+                                 std::pmr::vector<std::array<std::size_t, 3>> &ears) -> bool {
+        ring.clear();
+        ears.clear();
+        for (std::size_t i = 0; i < polygon.size(); i++) {
+            ring.push_back(i);
+        }
+
+        bool delaunay = true;
+        while (ring.size() > 3) {
+            std::size_t const size = ring.size();
+            std::size_t best = size;
+            bool best_delaunay = false;
+
+            for (std::size_t i = 0; i < size && !best_delaunay; i++) {
+                point_t const &a = polygon[ring[i]];
+                point_t const &b = polygon[ring[(i + 1) % size]];
+                point_t const &c = polygon[ring[(i + 2) % size]];
+                if (!point_t::counter_clock_wise(a, b, c)) {
+                    continue;
+                }
+
+                bool empty = true;
+                bool circle_empty = true;
+                for (std::size_t j = 3; j < size && empty; j++) {
+                    point_t const &other = polygon[ring[(i + j) % size]];
+                    empty = !(point_t::counter_clock_wise(a, b, other) && point_t::counter_clock_wise(b, c, other) &&
+                              point_t::counter_clock_wise(c, a, other));
+                    circle_empty = circle_empty && !point_t::in_circle(a, b, c, other);
+                }
+                if (empty && (best == size || circle_empty)) {
+                    best = i;
+                    best_delaunay = circle_empty;
+                }
+            }
+
+            // Numerically flat polygons may have no valid ear left, any one keeps the hole closed
+            if (best == size) {
+                best = 0;
+            }
+            delaunay = delaunay && best_delaunay;
+
+            std::size_t const middle = (best + 1) % size;
+            ears.push_back({ring[best], ring[middle], ring[(best + 2) % size]});
+            ring.erase(ring.begin() + static_cast<std::ptrdiff_t>(middle));
+        }
+        ears.push_back({ring[0], ring[1], ring[2]});
+        return delaunay;
+    }
+}// namespace delaunay
+
+#endif// DELAUNAY_HOLE_TRIANGULATION_HPP
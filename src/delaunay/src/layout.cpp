@@ -0,0 +1,192 @@
+#include "delaunay/delaunay.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+namespace delaunay {
+    namespace {
+        /**
+         * Resolution of the hilbert curve, per axis
+         */
+        constexpr std::uint32_t HILBERT_SIZE = 1U << 16U;
+
+        /**
+         * Position of a grid cell along the hilbert curve
+         * @param x cell column, smaller than HILBERT_SIZE
+         * @param y cell row, smaller than HILBERT_SIZE
+         * @return distance along the curve
+         */
+        auto hilbert_index(std::uint32_t x, std::uint32_t y) -> std::uint32_t {
+            std::uint32_t index = 0;
+            for (std::uint32_t s = HILBERT_SIZE / 2; s > 0; s /= 2) {
+                std::uint32_t const rx = (x & s) > 0 ? 1 : 0;
+                std::uint32_t const ry = (y & s) > 0 ? 1 : 0;
+                index += s * s * ((3 * rx) ^ ry);
+
+                // Rotate the quadrant, so the curve continues in the next one
+                if (ry == 0) {
+                    if (rx == 1) {
+                        x = HILBERT_SIZE - 1 - x;
+                        y = HILBERT_SIZE - 1 - y;
+                    }
+                    std::swap(x, y);
+                }
+            }
+            return index;
+        }
+
+        /**
+         * Maps every point to its cell on the hilbert curve, spanning the bounding box of all points
+         * @param points points to map
+         * @param resource memory resource of the result
+         * @return hilbert index of every point
+         */
+        auto hilbert_keys(std::pmr::vector<point_t> const &points, std::pmr::memory_resource *resource)
+            -> std::pmr::vector<std::uint32_t> {
+            scalar_t min_x = points.front().x;
+            scalar_t max_x = points.front().x;
+            scalar_t min_y = points.front().y;
+            scalar_t max_y = points.front().y;
+            for (auto const &point : points) {
+                min_x = std::min(min_x, point.x);
+                max_x = std::max(max_x, point.x);
+                min_y = std::min(min_y, point.y);
+                max_y = std::max(max_y, point.y);
+            }
+
+            // One scale for both axes keeps cells square
+            scalar_t const extent = std::max(max_x - min_x, max_y - min_y);
+            scalar_t const scale = extent > 0 ? (HILBERT_SIZE - 1) / extent : 0;
+
+            std::pmr::vector<std::uint32_t> keys(points.size(), resource);
+            parallel::parallel_for(points.size(), [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    auto const x = static_cast<std::uint32_t>((points[i].x - min_x) * scale);
+                    auto const y = static_cast<std::uint32_t>((points[i].y - min_y) * scale);
+                    keys[i] = hilbert_index(std::min(x, HILBERT_SIZE - 1), std::min(y, HILBERT_SIZE - 1));
+                }
+            });
+            return keys;
+        }
+    }// namespace
+
+    void Delaunay::optimize_layout() {
+        if (hull_edge == nullptr) {
+            return;
+        }
+
+        std::pmr::memory_resource *resource = memory_resource();
+
+        // Renumber the vertices along the hilbert curve
+        std::pmr::vector<std::uint32_t> const keys = hilbert_keys(vertices, resource);
+        std::pmr::vector<std::size_t> vertex_order(vertices.size(), resource);
+        std::iota(vertex_order.begin(), vertex_order.end(), std::size_t{0});
+        parallel::sort(vertex_order.begin(), vertex_order.end(), [&keys](std::size_t a, std::size_t b) {
+            return keys[a] != keys[b] ? keys[a] < keys[b] : a < b;
+        });
+
+        std::pmr::vector<std::size_t> new_vertex(vertices.size(), resource);
+        std::pmr::vector<point_t> ordered_vertices(resource);
+        ordered_vertices.reserve(vertices.size());
+        for (std::size_t vertex : vertex_order) {
+            new_vertex[vertex] = ordered_vertices.size();
+            ordered_vertices.push_back(vertices[vertex]);
+        }
+        vertices = std::move(ordered_vertices);
+        remap_vertex_attributes(vertex_order, new_vertex);
+        renumber_changes(new_vertex);
+
+        // Snapshots do not contain the input mapping
+        if (!vertex_origins.empty()) {
+            std::pmr::vector<std::size_t> ordered_origins(vertex_origins.size(), resource);
+            for (std::size_t vertex = 0; vertex < vertex_order.size(); vertex++) {
+                ordered_origins[vertex] = vertex_origins[vertex_order[vertex]];
+            }
+            vertex_origins = std::move(ordered_origins);
+            for (std::size_t &vertex : input_vertices) {
+                if (vertex != QuadEdge::INVALID_INDEX) {
+                    vertex = new_vertex[vertex];
+                }
+            }
+        }
+
+        // Order the live edges by their (renumbered) endpoints, so the edges around a vertex are stored together
+        std::pmr::vector<std::size_t> edge_order(resource);
+        edge_order.reserve(primary_edges.size());
+        for (std::size_t edge = 0; edge < primary_edges.size(); edge++) {
+            if (!primary_edges[edge]->is_deleted()) {
+                edge_order.push_back(edge);
+            }
+        }
+
+        auto endpoints = [this, &new_vertex](std::size_t edge) {
+            std::size_t const origin = new_vertex[primary_edges[edge]->origin_index()];
+            std::size_t const destination = new_vertex[primary_edges[edge]->destination_index()];
+            return std::pair(std::min(origin, destination), std::max(origin, destination));
+        };
+        parallel::sort(edge_order.begin(), edge_order.end(),
+                       [&endpoints](std::size_t a, std::size_t b) { return endpoints(a) < endpoints(b); });
+
+        // Allocate the new storage in that order, deleted edges are dropped
+        // Same resource as the current pool, so moving the pool below keeps the blocks in place
+        EdgePool relaid(resource);
+        std::pmr::vector<QuadEdge *> new_primary(primary_edges.size(), nullptr, resource);
+        for (std::size_t edge : edge_order) {
+            QuadEdge *old_edge = primary_edges[edge];
+            std::size_t const origin = new_vertex[old_edge->origin_index()];
+            std::size_t const destination = new_vertex[old_edge->destination_index()];
+            new_primary[edge] = relaid.allocate(vertices[origin], origin, vertices[destination], destination);
+        }
+
+        // The quarter edges of an edge are stored in rot order, so the id locates the new quarter edge
+        auto relocate = [&new_primary](QuadEdge *old_edge) {
+            return new_primary[old_edge->m_id / 4] + old_edge->m_id % 4;
+        };
+
+        // Copy the links, live edges only link to live edges
+        parallel::parallel_for(edge_order.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                QuadEdge *old_edge = primary_edges[edge_order[i]];
+                QuadEdge *new_edge = new_primary[edge_order[i]];
+
+                for (std::size_t r = 0; r < 4; r++) {
+                    QuadEdge *old_quarter = old_edge + r;
+                    QuadEdge *new_quarter = new_edge + r;
+
+                    new_quarter->state = old_quarter->state;
+                    new_quarter->m_id = 4 * i + r;
+                    new_quarter->p_onext = relocate(old_quarter->p_onext);
+                    new_quarter->p_rot = relocate(old_quarter->p_rot);
+
+                    // Faces are numbered again below
+                    if (r % 2 == 1) {
+                        new_quarter->m_origin_index = QuadEdge::INVALID_INDEX;
+                    }
+                }
+            }
+        });
+
+        hull_edge = relocate(hull_edge);
+
+        primary_edges.clear();
+        dual_edges.clear();
+        primary_sym_edges.clear();
+        dual_sym_edges.clear();
+        for (std::size_t edge : edge_order) {
+            QuadEdge *primary = new_primary[edge];
+            primary_edges.push_back(primary);
+            dual_edges.push_back(primary + 1);
+            primary_sym_edges.push_back(primary + 2);
+            dual_sym_edges.push_back(primary + 3);
+        }
+
+        // Release the old storage
+        edge_pool = std::move(relaid);
+
+        // Number the faces in the new edge order
+        calculate_vornoi_graph();
+    }
+}// namespace delaunay
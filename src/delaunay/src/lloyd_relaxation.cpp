@@ -0,0 +1,250 @@
+#include "delaunay/lloyd_relaxation.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace delaunay {
+    namespace {
+        /**
+         * Clips a polygon against one side of an axis parallel line (one step of Sutherland-Hodgman)
+         * @param polygon polygon to clip
+         * @param result clipped polygon
+         * @param vertical true to clip against x = bound, false for y = bound
+         * @param bound position of the line
+         * @param keep_greater true to keep the side with coordinates >= bound
+         */
+        void clip_polygon(std::vector<point_t> const &polygon, std::vector<point_t> &result, bool vertical,
+                          scalar_t bound, bool keep_greater) {
+            result.clear();
+            auto coordinate = [vertical](point_t const &point) { return vertical ? point.x : point.y; };
+            auto inside = [&](point_t const &point) {
+                return keep_greater ? coordinate(point) >= bound : coordinate(point) <= bound;
+            };
+
+            for (std::size_t i = 0; i < polygon.size(); i++) {
+                point_t const &current = polygon[i];
+                point_t const &next = polygon[(i + 1) % polygon.size()];
+
+                if (inside(current)) {
+                    result.push_back(current);
+                }
+                if (inside(current) != inside(next)) {
+                    scalar_t const t = (bound - coordinate(current)) / (coordinate(next) - coordinate(current));
+                    result.emplace_back(current.x + t * (next.x - current.x), current.y + t * (next.y - current.y));
+                }
+            }
+        }
+
+        /**
+         * Unit vector
+         */
+        auto normalize(scalar_t x, scalar_t y) -> point_t {
+            scalar_t const length = std::hypot(x, y);
+            return length > 0 ? point_t(x / length, y / length) : point_t(0, 0);
+        }
+    }// namespace
+
+    LloydRelaxation::LloydRelaxation(Delaunay &triangulation) :
+        triangulation(triangulation),
+        min(0, 0),
+        max(0, 0) {
+        auto const &vertices = triangulation.get_vertices();
+        if (vertices.empty()) {
+            return;
+        }
+
+        min = vertices.front();
+        max = vertices.front();
+        for (auto const &vertex : vertices) {
+            min = point_t(std::min(min.x, vertex.x), std::min(min.y, vertex.y));
+            max = point_t(std::max(max.x, vertex.x), std::max(max.y, vertex.y));
+        }
+    }
+
+    LloydRelaxation::LloydRelaxation(Delaunay &triangulation, point_t const &min, point_t const &max) :
+        triangulation(triangulation),
+        min(min),
+        max(max) {}
+
+    auto LloydRelaxation::relax(std::size_t max_iterations, scalar_t tolerance) -> std::size_t {
+        for (std::size_t iteration = 0; iteration < max_iterations; iteration++) {
+            if (step() <= tolerance) {
+                return iteration + 1;
+            }
+        }
+        return max_iterations;
+    }
+
+    auto LloydRelaxation::step() -> scalar_t {
+        // Without triangles there are no vornoi vertices
+        if (triangulation.get_faces().empty()) {
+            return 0;
+        }
+
+        compute_centroids();
+
+        auto const &vertices = triangulation.get_vertices();
+        scalar_t largest_move = 0;
+        for (std::size_t vertex = 0; vertex < vertices.size(); vertex++) {
+            largest_move = std::max(largest_move, std::hypot(centroids[vertex].x - vertices[vertex].x,
+                                                             centroids[vertex].y - vertices[vertex].y));
+        }
+
+        limit_moves();
+        if (!triangulation.move_vertices(centroids)) {
+            rebuild_count++;
+        }
+        return largest_move;
+    }
+
+    auto LloydRelaxation::get_rebuild_count() const -> std::size_t {
+        return rebuild_count;
+    }
+
+    void LloydRelaxation::limit_moves() {
+        auto const &vertices = triangulation.get_vertices();
+        auto const &faces = triangulation.get_faces();
+        auto const &face_edges = triangulation.get_face_edges();
+
+        // Triangles on the hull may invert, the vertex crossing the hull becomes a hull vertex
+        std::vector<char> on_hull(face_edges.size(), 0);
+        for (std::size_t face = 0; face < face_edges.size(); face++) {
+            QuadEdge *edge = face_edges[face];
+            for (QuadEdge *side : {edge, edge->left_face_next(), edge->left_face_prev()}) {
+                if (side->sym()->left_face_index() == QuadEdge::INVALID_INDEX) {
+                    on_hull[face] = 1;
+                }
+            }
+        }
+
+        // Vertices of other triangles that would be inverted move half as far, after a few halvings not at all.
+        // The original positions form a valid triangulation, so this ends.
+        std::vector<std::uint8_t> halvings(vertices.size(), 0);
+        std::vector<std::size_t> inverted;
+        while (true) {
+            inverted.clear();
+            for (std::size_t face = 0; face < faces.size(); face += 3) {
+                if (on_hull[face / 3] == 0 &&
+                    !point_t::counter_clock_wise(centroids[faces[face]], centroids[faces[face + 1]],
+                                                 centroids[faces[face + 2]])) {
+                    inverted.insert(inverted.end(), {faces[face], faces[face + 1], faces[face + 2]});
+                }
+            }
+            if (inverted.empty()) {
+                return;
+            }
+
+            std::sort(inverted.begin(), inverted.end());
+            inverted.erase(std::unique(inverted.begin(), inverted.end()), inverted.end());
+            for (std::size_t vertex : inverted) {
+                if (++halvings[vertex] > MAX_HALVINGS) {
+                    centroids[vertex] = vertices[vertex];
+                } else {
+                    centroids[vertex] = point_t((vertices[vertex].x + centroids[vertex].x) / 2,
+                                                (vertices[vertex].y + centroids[vertex].y) / 2);
+                }
+            }
+        }
+    }
+
+    void LloydRelaxation::compute_centroids() {
+        auto const &vertices = triangulation.get_vertices();
+
+        vertex_edges.assign(vertices.size(), nullptr);
+        for (QuadEdge *edge : triangulation.get_primary_edges()) {
+            if (!edge->is_deleted()) {
+                vertex_edges[edge->origin_index()] = edge;
+                vertex_edges[edge->destination_index()] = edge->sym();
+            }
+        }
+
+        centroids.assign(vertices.begin(), vertices.end());
+        parallel::parallel_for(vertices.size(), [this](std::size_t begin, std::size_t end) {
+            std::vector<point_t> cell;
+            std::vector<point_t> clipped;
+            for (std::size_t vertex = begin; vertex < end; vertex++) {
+                if (vertex_edges[vertex] != nullptr) {
+                    centroids[vertex] = cell_centroid(vertex_edges[vertex], cell, clipped);
+                }
+            }
+        });
+    }
+
+    auto LloydRelaxation::cell_centroid(QuadEdge *edge, std::vector<point_t> &cell, std::vector<point_t> &clipped) const
+        -> point_t {
+        auto const &circumcenters = triangulation.get_circumcenters();
+        point_t const site = edge->origin();
+
+        // A hull vertex has the outer face left of exactly one of its edges
+        QuadEdge *gap = nullptr;
+        QuadEdge *current = edge;
+        do {
+            if (current->left_face_index() == QuadEdge::INVALID_INDEX) {
+                gap = current;
+                break;
+            }
+            current = current->orbit_next();
+        } while (current != edge);
+
+        // The vornoi vertices of the cell are the circumcenters of the faces around the vertex, counter clockwise
+        cell.clear();
+        QuadEdge *start = gap == nullptr ? edge : gap->orbit_next();
+        QuadEdge *stop = gap == nullptr ? edge : gap;
+        if (start == gap) {
+            return site;
+        }
+        current = start;
+        do {
+            cell.push_back(circumcenters[current->left_face_index()]);
+            current = current->orbit_next();
+        } while (current != stop);
+
+        // The cell of a hull vertex is unbounded, it is closed far outside the rectangle
+        // along the bisectors of both hull edges
+        if (gap != nullptr) {
+            scalar_t const extent = std::hypot(max.x - min.x, max.y - min.y);
+            point_t const center((min.x + max.x) / 2, (min.y + max.y) / 2);
+            auto far = [&](point_t const &base, point_t const &direction) {
+                scalar_t const distance = std::hypot(base.x - center.x, base.y - center.y) + 2 * extent + 1;
+                return point_t(base.x + distance * direction.x, base.y + distance * direction.y);
+            };
+
+            point_t const leaving = normalize(-(gap->destination().y - site.y), gap->destination().x - site.x);
+            point_t const entering = normalize(start->destination().y - site.y, -(start->destination().x - site.x));
+            point_t const last = cell.back();
+            point_t const first = cell.front();
+
+            cell.push_back(far(last, leaving));
+            cell.push_back(far(site, normalize(leaving.x + entering.x, leaving.y + entering.y)));
+            cell.push_back(far(first, entering));
+        }
+
+        // Clip to the rectangle
+        clip_polygon(cell, clipped, true, min.x, true);
+        clip_polygon(clipped, cell, true, max.x, false);
+        clip_polygon(cell, clipped, false, min.y, true);
+        clip_polygon(clipped, cell, false, max.y, false);
+
+        // Centroid relative to the site, for precision
+        scalar_t area = 0;
+        scalar_t x = 0;
+        scalar_t y = 0;
+        for (std::size_t i = 0; i < cell.size(); i++) {
+            scalar_t const ax = cell[i].x - site.x;
+            scalar_t const ay = cell[i].y - site.y;
+            scalar_t const bx = cell[(i + 1) % cell.size()].x - site.x;
+            scalar_t const by = cell[(i + 1) % cell.size()].y - site.y;
+            scalar_t const cross = ax * by - bx * ay;
+            area += cross;
+            x += (ax + bx) * cross;
+            y += (ay + by) * cross;
+        }
+
+        if (std::abs(area) <= 0) {
+            return site;
+        }
+        return {site.x + x / (3 * area), site.y + y / (3 * area)};
+    }
+}// namespace delaunay
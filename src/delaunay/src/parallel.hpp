@@ -0,0 +1,90 @@
+#ifndef DELAUNAY_PARALLEL_HPP
+#define DELAUNAY_PARALLEL_HPP
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+namespace delaunay::parallel {
+    /**
+     * Ranges smaller than this are processed on the calling thread,
+     * as distributing them costs more than the work itself
+     */
+    constexpr std::size_t MIN_PARALLEL_SIZE = 1U << 14U;
+
+    /**
+     * Number of threads used for parallel work
+     * @return number of threads in the shared pool (at least 1)
+     */
+    inline auto worker_count() -> std::size_t {
+        return ThreadPool::instance().size();
+    }
+
+    /**
+     * Number of workers worth using for a range of the given size
+     * @param count number of elements
+     * @return number of workers (at least 1)
+     */
+    inline auto workers_for(std::size_t count) -> std::size_t {
+        return std::max<std::size_t>(1, std::min(worker_count(), count / MIN_PARALLEL_SIZE));
+    }
+
+    /**
+     * Calls fn(task) for every task in [0, tasks) on the shared thread pool
+     * @param tasks number of tasks
+     * @param fn function called with the task index
+     */
+    template<class Function>
+    void run_tasks(std::size_t tasks, Function const &fn) {
+        ThreadPool::instance().run(tasks, [&fn](std::size_t task) { fn(task); });
+    }
+
+    /**
+     * Splits [0, count) into one contiguous chunk per worker and calls fn(begin, end) for each chunk in parallel
+     * @param count number of elements
+     * @param fn function called with the half open range [begin, end) of each chunk
+     */
+    template<class Function>
+    void parallel_for(std::size_t count, Function const &fn) {
+        std::size_t const workers = workers_for(count);
+        std::size_t const chunk = (count + workers - 1) / workers;
+
+        run_tasks(workers, [&](std::size_t task) {
+            std::size_t const begin = std::min(task * chunk, count);
+            fn(begin, std::min(begin + chunk, count));
+        });
+    }
+
+    /**
+     * Sorts the range [first, last) by sorting one chunk per worker in parallel
+     * and merging neighbouring chunks pairwise afterwards
+     * @param first begin of the range
+     * @param last end of the range
+     * @param compare strict weak ordering
+     */
+    template<class RandomIt, class Compare>
+    void sort(RandomIt first, RandomIt last, Compare compare) {
+        auto const count = static_cast<std::size_t>(std::distance(first, last));
+        std::size_t const workers = workers_for(count);
+        std::size_t const chunk = (count + workers - 1) / workers;
+
+        // Sort chunks independently
+        parallel_for(count, [&](std::size_t begin, std::size_t end) {
+            std::sort(first + begin, first + end, compare);
+        });
+
+        // Merge sorted chunks, doubling the width each round
+        for (std::size_t width = chunk; width < count; width *= 2) {
+            std::size_t const merges = (count - width + 2 * width - 1) / (2 * width);
+            run_tasks(merges, [&](std::size_t task) {
+                std::size_t const begin = task * 2 * width;
+                std::inplace_merge(first + begin, first + begin + width, first + std::min(begin + 2 * width, count),
+                                   compare);
+            });
+        }
+    }
+}// namespace delaunay::parallel
+
+#endif// DELAUNAY_PARALLEL_HPP
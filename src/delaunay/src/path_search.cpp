@@ -0,0 +1,206 @@
+#include "delaunay/path_search.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace delaunay {
+    namespace {
+        auto distance(point_t const &a, point_t const &b) -> scalar_t {
+            return std::hypot(a.x - b.x, a.y - b.y);
+        }
+
+        /**
+         * Min-heap order on the estimated total cost
+         */
+        auto heap_order(std::pair<scalar_t, std::size_t> const &a, std::pair<scalar_t, std::size_t> const &b)
+            -> bool {
+            return a.first > b.first;
+        }
+    }// namespace
+
+    PathSearch::PathSearch(Delaunay &triangulation) :
+        triangulation(triangulation),
+        epoch(0),
+        path_cost(0),
+        expanded_nodes(0) {
+        reset();
+    }
+
+    void PathSearch::reset() {
+        // Two primary half edges per edge, nodes are indexed by half edge
+        std::size_t const node_count = 2 * triangulation.get_primary_edges().size();
+        if (node_epochs.size() != node_count) {
+            node_epochs.assign(node_count, 0);
+            node_states.resize(node_count);
+            node_costs.resize(node_count);
+            node_edges.resize(node_count);
+            node_parents.resize(node_count);
+            epoch = 0;
+        }
+
+        epoch++;
+        if (epoch == 0) {
+            // Counter wrapped around, old marks could become valid again
+            std::fill(node_epochs.begin(), node_epochs.end(), 0);
+            epoch = 1;
+        }
+
+        open_set.clear();
+        path.clear();
+        path_cost = 0;
+        expanded_nodes = 0;
+    }
+
+    auto PathSearch::node_index(QuadEdge *edge, Graph graph) -> std::size_t {
+        if (graph == Graph::EDGE_MIDPOINTS) {
+            // Both directions of an edge are the same node
+            return edge->id() / 4 * 2;
+        }
+
+        // All three half edges of a face are the same node, the one with the lowest id represents it
+        QuadEdge *next = edge->left_face_next();
+        return std::min({edge->id(), next->id(), next->left_face_next()->id()}) / 2;
+    }
+
+    auto PathSearch::node_position(QuadEdge *edge, Graph graph) -> point_t {
+        point_t const &a = edge->origin();
+        point_t const &b = edge->destination();
+        if (graph == Graph::EDGE_MIDPOINTS) {
+            return {(a.x + b.x) / 2, (a.y + b.y) / 2};
+        }
+
+        point_t const &c = edge->left_face_next()->destination();
+        return {(a.x + b.x + c.x) / 3, (a.y + b.y + c.y) / 3};
+    }
+
+    auto PathSearch::state(std::size_t node) -> SearchState {
+        return node_epochs[node] == epoch ? node_states[node] : SearchState::UNVISITED;
+    }
+
+    auto PathSearch::find_path(QuadEdge *start, QuadEdge *goal, Graph graph, cost_function_t const &edge_cost,
+                               bool use_heuristic) -> bool {
+        reset();
+
+        if (start == nullptr || goal == nullptr || start->is_deleted() || goal->is_deleted()) {
+            return false;
+        }
+        if (graph == Graph::FACES && (!start->is_left_face_triangle() || !goal->is_left_face_triangle())) {
+            return false;
+        }
+
+        point_t const goal_position = node_position(goal, graph);
+        std::size_t const goal_node = node_index(goal, graph);
+        auto heuristic = [&](point_t const &position) -> scalar_t {
+            return use_heuristic ? distance(position, goal_position) : 0;
+        };
+
+        std::size_t const start_node = node_index(start, graph);
+        node_epochs[start_node] = epoch;
+        node_states[start_node] = SearchState::OPEN;
+        node_costs[start_node] = 0;
+        node_edges[start_node] = start;
+        node_parents[start_node] = start_node;
+        open_set.emplace_back(heuristic(node_position(start, graph)), start_node);
+
+        while (!open_set.empty()) {
+            std::pop_heap(open_set.begin(), open_set.end(), heap_order);
+            std::size_t const node = open_set.back().second;
+            open_set.pop_back();
+
+            // Lazy deletion, a node can be in the heap multiple times
+            if (state(node) == SearchState::CLOSED) {
+                continue;
+            }
+            node_states[node] = SearchState::CLOSED;
+            expanded_nodes++;
+
+            if (node == goal_node) {
+                break;
+            }
+
+            QuadEdge *current = node_edges[node];
+            point_t const position = node_position(current, graph);
+
+            // Collects the neighbours: For FACES the faces behind the three edges of the face,
+            // for EDGE_MIDPOINTS the other two edges of both adjacent faces
+            QuadEdge *neighbours[4];
+            QuadEdge *crossed[4];
+            std::size_t neighbour_count = 0;
+            if (graph == Graph::FACES) {
+                QuadEdge *edge = current;
+                for (int i = 0; i < 3; i++, edge = edge->left_face_next()) {
+                    if (edge->sym()->is_left_face_triangle()) {
+                        neighbours[neighbour_count] = edge->sym();
+                        crossed[neighbour_count++] = edge;
+                    }
+                }
+            } else {
+                for (QuadEdge *side : {current, current->sym()}) {
+                    if (side->is_left_face_triangle()) {
+                        neighbours[neighbour_count] = side->left_face_next();
+                        crossed[neighbour_count++] = side->left_face_next();
+                        neighbours[neighbour_count] = side->left_face_prev();
+                        crossed[neighbour_count++] = side->left_face_prev();
+                    }
+                }
+            }
+
+            for (std::size_t i = 0; i < neighbour_count; i++) {
+                std::size_t const neighbour = node_index(neighbours[i], graph);
+                SearchState const neighbour_state = state(neighbour);
+                if (neighbour_state == SearchState::CLOSED) {
+                    continue;
+                }
+
+                point_t const neighbour_position = node_position(neighbours[i], graph);
+                scalar_t step = distance(position, neighbour_position);
+                if (edge_cost) {
+                    step += edge_cost(crossed[i]);
+                }
+                if (std::isinf(step)) {
+                    continue;
+                }
+
+                scalar_t const cost = node_costs[node] + step;
+                if (neighbour_state == SearchState::OPEN && node_costs[neighbour] <= cost) {
+                    continue;
+                }
+
+                node_epochs[neighbour] = epoch;
+                node_states[neighbour] = SearchState::OPEN;
+                node_costs[neighbour] = cost;
+                node_edges[neighbour] = neighbours[i];
+                node_parents[neighbour] = node;
+                open_set.emplace_back(cost + heuristic(neighbour_position), neighbour);
+                std::push_heap(open_set.begin(), open_set.end(), heap_order);
+            }
+        }
+
+        if (state(goal_node) != SearchState::CLOSED) {
+            return false;
+        }
+
+        // Walk back from the goal to the start
+        path_cost = node_costs[goal_node];
+        for (std::size_t node = goal_node; node != start_node; node = node_parents[node]) {
+            path.push_back(node_edges[node]);
+        }
+        path.push_back(node_edges[start_node]);
+        std::reverse(path.begin(), path.end());
+
+        return true;
+    }
+
+    auto PathSearch::get_path() -> std::vector<QuadEdge *> const & {
+        return path;
+    }
+
+    auto PathSearch::get_cost() const -> scalar_t {
+        return path_cost;
+    }
+
+    auto PathSearch::get_expanded_nodes() const -> std::size_t {
+        return expanded_nodes;
+    }
+}// namespace delaunay
@@ -0,0 +1,170 @@
+#include "delaunay/proximity_graphs.hpp"
+#include "parallel.hpp"
+
+#include <numeric>
+#include <utility>
+
+namespace delaunay {
+    namespace {
+        /**
+         * Disjoint set forest over the vertex indices, using path halving and union by size
+         */
+        class UnionFind {
+          public:
+            explicit UnionFind(std::size_t size) : parent(size), set_size(size, 1) {
+                std::iota(parent.begin(), parent.end(), std::size_t{0});
+            }
+
+            auto find(std::size_t element) -> std::size_t {
+                while (parent[element] != element) {
+                    parent[element] = parent[parent[element]];
+                    element = parent[element];
+                }
+                return element;
+            }
+
+            /**
+             * Joins the sets of a and b
+             * @return false if both already were in the same set
+             */
+            auto unite(std::size_t a, std::size_t b) -> bool {
+                a = find(a);
+                b = find(b);
+                if (a == b) {
+                    return false;
+                }
+
+                if (set_size[a] < set_size[b]) {
+                    std::swap(a, b);
+                }
+                parent[b] = a;
+                set_size[a] += set_size[b];
+                return true;
+            }
+
+          private:
+            std::vector<std::size_t> parent;
+            std::vector<std::size_t> set_size;
+        };
+
+        /**
+         * Returns whether the point c lies strictly inside the circle with diameter ab
+         */
+        auto in_diametral_circle(point_t const &a, point_t const &b, point_t const &c) -> bool {
+            // The angle acb is obtuse if c is inside the circle
+            return (a.x - c.x) * (b.x - c.x) + (a.y - c.y) * (b.y - c.y) < 0;
+        }
+
+        /**
+         * Returns whether any neighbour of the origin of edge lies inside the lune of the edge
+         */
+        auto lune_contains_neighbour(QuadEdge *edge, scalar_t length) -> bool {
+            QuadEdge *current = edge->orbit_next();
+            while (current != edge) {
+                if (current->destination_index() != edge->destination_index() &&
+                    ProximityGraphs::squared_length(current) < length) {
+                    scalar_t const dx = current->destination().x - edge->destination().x;
+                    scalar_t const dy = current->destination().y - edge->destination().y;
+                    if (dx * dx + dy * dy < length) {
+                        return true;
+                    }
+                }
+                current = current->orbit_next();
+            }
+            return false;
+        }
+
+        auto live_edges(Delaunay &triangulation) -> std::vector<QuadEdge *> {
+            std::vector<QuadEdge *> result;
+            result.reserve(triangulation.get_primary_edges().size());
+            for (QuadEdge *edge : triangulation.get_primary_edges()) {
+                if (!edge->is_deleted()) {
+                    result.push_back(edge);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * Keeps all edges for which the predicate holds, evaluating it in parallel
+         */
+        template<class Predicate>
+        auto filter_edges(std::vector<QuadEdge *> const &edges, Predicate const &predicate) -> std::vector<QuadEdge *> {
+            std::vector<char> keep(edges.size());
+            parallel::parallel_for(edges.size(), [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    keep[i] = static_cast<char>(predicate(edges[i]));
+                }
+            });
+
+            std::vector<QuadEdge *> result;
+            for (std::size_t i = 0; i < edges.size(); i++) {
+                if (keep[i] != 0) {
+                    result.push_back(edges[i]);
+                }
+            }
+            return result;
+        }
+
+        auto is_gabriel_edge(QuadEdge *edge) -> bool {
+            for (QuadEdge *side : {edge, edge->sym()}) {
+                if (side->is_left_face_triangle() &&
+                    in_diametral_circle(side->origin(), side->destination(), side->left_face_next()->destination())) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }// namespace
+
+    auto ProximityGraphs::squared_length(QuadEdge *edge) -> scalar_t {
+        scalar_t const dx = edge->destination().x - edge->origin().x;
+        scalar_t const dy = edge->destination().y - edge->origin().y;
+        return dx * dx + dy * dy;
+    }
+
+    auto ProximityGraphs::euclidean_minimum_spanning_tree(Delaunay &triangulation) -> std::vector<QuadEdge *> {
+        std::vector<std::pair<scalar_t, QuadEdge *>> candidates;
+        candidates.reserve(triangulation.get_primary_edges().size());
+        for (QuadEdge *edge : triangulation.get_primary_edges()) {
+            if (!edge->is_deleted()) {
+                candidates.emplace_back(squared_length(edge), edge);
+            }
+        }
+
+        parallel::sort(candidates.begin(), candidates.end(), [](auto const &a, auto const &b) {
+            return a.first < b.first;
+        });
+
+        std::size_t const vertex_count = triangulation.get_vertices().size();
+        UnionFind components(vertex_count);
+
+        std::vector<QuadEdge *> tree;
+        tree.reserve(vertex_count > 0 ? vertex_count - 1 : 0);
+        for (auto const &[length, edge] : candidates) {
+            if (components.unite(edge->origin_index(), edge->destination_index())) {
+                tree.push_back(edge);
+                if (tree.size() + 1 == vertex_count) {
+                    break;
+                }
+            }
+        }
+
+        return tree;
+    }
+
+    auto ProximityGraphs::gabriel_graph(Delaunay &triangulation) -> std::vector<QuadEdge *> {
+        return filter_edges(live_edges(triangulation), is_gabriel_edge);
+    }
+
+    auto ProximityGraphs::relative_neighbourhood_graph(Delaunay &triangulation) -> std::vector<QuadEdge *> {
+        return filter_edges(live_edges(triangulation), [](QuadEdge *edge) {
+            if (!is_gabriel_edge(edge)) {
+                return false;
+            }
+
+            scalar_t const length = squared_length(edge);
+            return !lune_contains_neighbour(edge, length) && !lune_contains_neighbour(edge->sym(), length);
+        });
+    }
+}// namespace delaunay
@@ -0,0 +1,292 @@
+#include "delaunay/delaunay.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <stdexcept>
+
+namespace delaunay {
+    auto Delaunay::move_vertices(std::span<point_t const> positions) -> bool {
+        if (positions.size() != vertices.size()) {
+            throw std::invalid_argument("Expected one position per vertex");
+        }
+        if (changes_tracked) {
+            for (std::size_t vertex = 0; vertex < vertices.size(); vertex++) {
+                if (!(positions[vertex] == vertices[vertex])) {
+                    moved_vertices.push_back(vertex);
+                    touch_vertex(vertex);
+                }
+            }
+        }
+        std::copy(positions.begin(), positions.end(), vertices.begin());
+
+        // Every primary quarter edge keeps a copy of its origin
+        parallel::parallel_for(primary_edges.size(), [this](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                for (QuadEdge *edge : {primary_edges[i], primary_sym_edges[i]}) {
+                    if (edge->state != EdgeState::DELETED) {
+                        edge->m_origin = vertices[edge->m_origin_index];
+                    }
+                }
+            }
+        });
+
+        if (hull_edge == nullptr) {
+            record_changes({}, false);
+            return true;
+        }
+
+        if (!release_inverted_faces() || !make_hull_convex() || !restore_delaunay()) {
+            rebuild();
+            return false;
+        }
+
+        update_vornoi_graph();
+        return true;
+    }
+
+    void Delaunay::rebuild() {
+        std::pmr::memory_resource *resource = memory_resource();
+        std::pmr::vector<point_t> const positions(vertices, resource);
+        std::pmr::vector<std::size_t> const previous_origins(vertex_origins, resource);
+        std::pmr::vector<std::size_t> previous_inputs(input_vertices, resource);
+        if (changes_tracked) {
+            previous_faces.swap(faces);
+        }
+
+        clear();
+        set_vertices(positions);
+        remap_vertex_attributes(vertex_origins, input_vertices);
+        std::pmr::vector<std::size_t> renumbering(resource);
+        if (changes_tracked) {
+            renumbering.assign(input_vertices.begin(), input_vertices.end());
+        }
+
+        // set_vertices mapped the previous vertices, map the original input through them
+        if (previous_origins.empty()) {
+            vertex_origins.clear();
+            input_vertices.clear();
+        } else {
+            for (std::size_t &origin : vertex_origins) {
+                origin = previous_origins[origin];
+            }
+            // Inputs of removed vertices stay removed
+            for (std::size_t &vertex : previous_inputs) {
+                if (vertex != QuadEdge::INVALID_INDEX) {
+                    vertex = input_vertices[vertex];
+                }
+            }
+            input_vertices.assign(previous_inputs.begin(), previous_inputs.end());
+        }
+
+        build();
+        record_changes(renumbering, true);
+    }
+
+    auto Delaunay::release_inverted_faces() -> bool {
+        // Without triangles (collinear vertices) there is nothing to repair
+        if (faces.empty()) {
+            return false;
+        }
+
+        // The faces of the previous vornoi graph still describe the current edges
+        std::atomic<bool> valid{true};
+        parallel::parallel_for(faces.size() / 3, [this, &valid](std::size_t begin, std::size_t end) {
+            for (std::size_t face = begin; face < end && valid; face++) {
+                if (!point_t::counter_clock_wise(vertices[faces[3 * face]], vertices[faces[3 * face + 1]],
+                                                 vertices[faces[3 * face + 2]])) {
+                    valid = false;
+                }
+            }
+        });
+        if (valid) {
+            return true;
+        }
+
+        // A vertex that moved across a hull edge becomes a hull vertex itself, once the hull edge is removed.
+        // Then its triangle belongs to the outer face and the hull may need closing, see make_hull_convex()
+        for (std::size_t face = 0; face < faces.size() / 3; face++) {
+            if (point_t::counter_clock_wise(vertices[faces[3 * face]], vertices[faces[3 * face + 1]],
+                                            vertices[faces[3 * face + 2]])) {
+                continue;
+            }
+
+            QuadEdge *sides[] = {face_edges[face], face_edges[face]->left_face_next(),
+                                 face_edges[face]->left_face_prev()};
+            auto is_hull_side = [](QuadEdge *side) {
+                return side->sym()->left_face_index() == QuadEdge::INVALID_INDEX;
+            };
+            std::size_t const hull_sides = std::count_if(std::begin(sides), std::end(sides), is_hull_side);
+            if (hull_sides != 1) {
+                return false;
+            }
+
+            // Rotate so the hull side comes first, the opposite vertex must be interior
+            while (!is_hull_side(sides[0])) {
+                std::rotate(std::begin(sides), std::begin(sides) + 1, std::end(sides));
+            }
+            QuadEdge *around = sides[1]->sym();
+            do {
+                if (around->left_face_index() == QuadEdge::INVALID_INDEX) {
+                    return false;
+                }
+                around = around->orbit_next();
+            } while (around != sides[1]->sym());
+
+            for (QuadEdge *side : sides) {
+                touch_vertex(side->origin_index());
+            }
+
+            // The remaining sides border the outer face from now on
+            sides[1]->inv_rot()->m_origin_index = QuadEdge::INVALID_INDEX;
+            sides[2]->inv_rot()->m_origin_index = QuadEdge::INVALID_INDEX;
+            hull_edge = sides[2]->sym();
+            delete_edge(sides[0]);
+        }
+        return true;
+    }
+
+    auto Delaunay::make_hull_convex() -> bool {
+        while (true) {
+            auto const hull = get_convex_hull();
+
+            // Find a hull vertex with a right turn, e.g. one that moved inwards
+            std::size_t reflex = 0;
+            while (reflex < hull.size() &&
+                   !point_t::counter_clock_wise(hull[reflex]->origin(), hull[(reflex + 1) % hull.size()]->destination(),
+                                                hull[reflex]->destination())) {
+                reflex++;
+            }
+            if (reflex == hull.size()) {
+                // Without right turns the hull must wind around exactly once
+                double turning = 0;
+                for (std::size_t i = 0; i < hull.size(); i++) {
+                    QuadEdge *current = hull[i];
+                    QuadEdge *next = hull[(i + 1) % hull.size()];
+                    double const ax = current->destination().x - current->origin().x;
+                    double const ay = current->destination().y - current->origin().y;
+                    double const bx = next->destination().x - next->origin().x;
+                    double const by = next->destination().y - next->origin().y;
+                    turning += std::atan2(ax * by - ay * bx, ax * bx + ay * by);
+                }
+                return turning < 3 * std::numbers::pi;
+            }
+
+            QuadEdge *incoming = hull[reflex];
+            QuadEdge *outgoing = hull[(reflex + 1) % hull.size()];
+            auto const &u = incoming->origin();
+            auto const &v = incoming->destination();
+            auto const &w = outgoing->destination();
+
+            // Closing the pocket adds the triangle (v, u, w) outside the hull, which must not contain hull vertices
+            for (QuadEdge *edge : hull) {
+                auto const &point = edge->origin();
+                if (point_t::counter_clock_wise(v, u, point) && point_t::counter_clock_wise(u, w, point) &&
+                    point_t::counter_clock_wise(w, v, point)) {
+                    return false;
+                }
+            }
+
+            // The new edge u -> w has the new triangle on its left and becomes the hull edge
+            touch_vertex(incoming->origin_index());
+            touch_vertex(incoming->destination_index());
+            touch_vertex(outgoing->destination_index());
+            hull_edge = connect_edges(incoming->sym(), outgoing->sym());
+        }
+    }
+
+    auto Delaunay::restore_delaunay() -> bool {
+        std::pmr::vector<QuadEdge *> stack(memory_resource());
+        std::pmr::vector<char> queued(primary_edges.size(), 0, memory_resource());
+        for (QuadEdge *edge : primary_edges) {
+            if (!edge->is_deleted()) {
+                stack.push_back(edge);
+                queued[edge->id() / 4] = 1;
+            }
+        }
+
+        // The predicates are not exact, so cycling flips are cut off and handled by a rebuild
+        std::size_t flip_budget = 8 * stack.size() + 64;
+
+        while (!stack.empty()) {
+            QuadEdge *edge = stack.back();
+            stack.pop_back();
+            queued[edge->id() / 4] = 0;
+
+            // Hull edges have only one triangle
+            if (!edge->is_left_face_triangle() || !edge->sym()->is_left_face_triangle()) {
+                continue;
+            }
+
+            auto const &a = edge->origin();
+            auto const &b = edge->destination();
+            auto const &c = edge->left_face_next()->destination();
+            auto const &d = edge->sym()->left_face_next()->destination();
+            if (!point_t::in_circle(a, b, c, d)) {
+                continue;
+            }
+
+            // Only flip if both new triangles are counter clockwise
+            if (!point_t::counter_clock_wise(a, d, c) || !point_t::counter_clock_wise(b, c, d)) {
+                continue;
+            }
+            if (flip_budget-- == 0) {
+                return false;
+            }
+
+            flip_edge(edge);
+
+            // The four edges of the quadrilateral may no longer be locally Delaunay
+            for (QuadEdge *side : {edge->left_face_next(), edge->left_face_prev(), edge->sym()->left_face_next(),
+                                   edge->sym()->left_face_prev()}) {
+                std::size_t const index = side->id() / 4;
+                if (queued[index] == 0) {
+                    queued[index] = 1;
+                    stack.push_back(primary_edges[index]);
+                }
+            }
+        }
+        return true;
+    }
+
+    void Delaunay::flip_edge(QuadEdge *edge) {
+        // Swap from Guibas and Stolfi: detach the edge and reconnect it between the two opposite vertices
+        QuadEdge *a = edge->orbit_prev();
+        QuadEdge *b = edge->sym()->orbit_prev();
+        touch_vertex(edge->origin_index());
+        touch_vertex(edge->destination_index());
+
+        splice_edges(edge, a);
+        splice_edges(edge->sym(), b);
+        splice_edges(edge, a->left_face_next());
+        splice_edges(edge->sym(), b->left_face_next());
+
+        std::size_t const origin = a->destination_index();
+        std::size_t const destination = b->destination_index();
+        edge->m_origin_index = origin;
+        edge->m_origin = vertices[origin];
+        edge->sym()->m_origin_index = destination;
+        edge->sym()->m_origin = vertices[destination];
+        touch_vertex(origin);
+        touch_vertex(destination);
+    }
+
+    void Delaunay::update_vornoi_graph() {
+        for (QuadEdge *edge : dual_edges) {
+            edge->m_origin_index = QuadEdge::INVALID_INDEX;
+        }
+        for (QuadEdge *edge : dual_sym_edges) {
+            edge->m_origin_index = QuadEdge::INVALID_INDEX;
+        }
+
+        // The faces before the change are compared to the new ones around the touched vertices
+        if (changes_tracked) {
+            previous_faces.swap(faces);
+        }
+        calculate_vornoi_graph();
+        record_changes({}, false);
+    }
+}// namespace delaunay
@@ -0,0 +1,354 @@
+#include "delaunay/delaunay.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DELAUNAY_HAS_MMAP 1
+#endif
+
+namespace delaunay {
+    namespace {
+        /**
+         * Snapshot layout:
+         * [header, padded to a page][vertices][onext][origin indices][states][faces][face edges][circumcenters]
+         * Every section starts at a multiple of PAGE_SIZE, all indices are stored as uint32.
+         */
+        constexpr std::array<char, 8> MAGIC{'D', 'L', 'N', 'Y', 'S', 'N', 'A', 'P'};
+        constexpr std::uint32_t VERSION = 1;
+        constexpr std::uint32_t ENDIANNESS = 0x01020304;
+        constexpr std::uint64_t PAGE_SIZE = 4096;
+        constexpr std::uint32_t NO_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+        enum Section : std::size_t {
+            VERTICES = 0,
+            ONEXT,
+            ORIGIN_INDICES,
+            STATES,
+            FACES,
+            FACE_EDGES,
+            CIRCUMCENTERS,
+            SECTION_COUNT,
+        };
+
+        struct SectionEntry {
+            std::uint64_t offset;
+            std::uint64_t size;
+        };
+
+        struct Header {
+            std::array<char, 8> magic;
+            std::uint32_t version;
+            std::uint32_t endianness;
+            std::uint64_t vertex_count;
+            std::uint64_t edge_count;
+            std::uint64_t face_count;
+            std::uint64_t hull_edge;
+            std::array<SectionEntry, SECTION_COUNT> sections;
+        };
+
+        static_assert(sizeof(Header) <= PAGE_SIZE);
+        static_assert(sizeof(point_t) == 2 * sizeof(scalar_t), "Points are stored as two scalars");
+
+        auto to_index(std::size_t index) -> std::uint32_t {
+            if (index == QuadEdge::INVALID_INDEX) {
+                return NO_INDEX;
+            }
+            if (index >= NO_INDEX) {
+                throw std::runtime_error("Triangulation is too large for a snapshot");
+            }
+            return static_cast<std::uint32_t>(index);
+        }
+
+        auto from_index(std::uint32_t index) -> std::size_t {
+            return index == NO_INDEX ? QuadEdge::INVALID_INDEX : index;
+        }
+
+        auto align_to_page(std::uint64_t offset) -> std::uint64_t {
+            return (offset + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+        }
+
+        /**
+         * Read only view of a whole file, memory mapped where supported
+         */
+        class MappedFile {
+          public:
+            explicit MappedFile(std::filesystem::path const &path) {
+#ifdef DELAUNAY_HAS_MMAP
+                int const file = ::open(path.c_str(), O_RDONLY);
+                if (file < 0) {
+                    throw std::runtime_error("Can not open snapshot " + path.string());
+                }
+
+                struct stat info {};
+                if (::fstat(file, &info) != 0) {
+                    ::close(file);
+                    throw std::runtime_error("Can not read snapshot " + path.string());
+                }
+
+                length = static_cast<std::size_t>(info.st_size);
+                if (length > 0) {
+                    void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+                    if (mapping == MAP_FAILED) {
+                        ::close(file);
+                        throw std::runtime_error("Can not map snapshot " + path.string());
+                    }
+                    bytes = static_cast<char const *>(mapping);
+                }
+                ::close(file);
+#else
+                std::ifstream file(path, std::ios::binary | std::ios::ate);
+                if (!file) {
+                    throw std::runtime_error("Can not open snapshot " + path.string());
+                }
+                buffer.resize(static_cast<std::size_t>(file.tellg()));
+                file.seekg(0);
+                file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                bytes = buffer.data();
+                length = buffer.size();
+#endif
+            }
+
+            ~MappedFile() {
+#ifdef DELAUNAY_HAS_MMAP
+                if (bytes != nullptr) {
+                    ::munmap(const_cast<char *>(bytes), length);
+                }
+#endif
+            }
+
+            MappedFile(MappedFile const &other) = delete;
+            MappedFile(MappedFile &&other) = delete;
+            auto operator=(MappedFile const &other) -> MappedFile & = delete;
+            auto operator=(MappedFile &&other) -> MappedFile & = delete;
+
+            /**
+             * Returns a section of the file as array of T, checking its bounds
+             */
+            template<class T>
+            auto section(SectionEntry const &entry, std::uint64_t count) const -> T const * {
+                if (count > length / sizeof(T) || entry.size != count * sizeof(T) || entry.offset % PAGE_SIZE != 0 ||
+                    entry.offset > length || entry.size > length - entry.offset) {
+                    throw std::runtime_error("Snapshot section is out of bounds");
+                }
+                return reinterpret_cast<T const *>(bytes + entry.offset);
+            }
+
+            [[nodiscard]] auto data() const -> char const * {
+                return bytes;
+            }
+
+            [[nodiscard]] auto size() const -> std::size_t {
+                return length;
+            }
+
+          private:
+            char const *bytes = nullptr;
+            std::size_t length = 0;
+#ifndef DELAUNAY_HAS_MMAP
+            std::vector<char> buffer;
+#endif
+        };
+
+        /**
+         * Writes the sections one after another, each padded to the next page
+         */
+        class SnapshotWriter {
+          public:
+            explicit SnapshotWriter(std::filesystem::path const &path) : file(path, std::ios::binary | std::ios::trunc) {
+                if (!file) {
+                    throw std::runtime_error("Can not create snapshot " + path.string());
+                }
+                // Space for the header, written last
+                pad_to(PAGE_SIZE);
+            }
+
+            template<class T, class Allocator>
+            auto write(std::vector<T, Allocator> const &values) -> SectionEntry {
+                SectionEntry const entry{position, values.size() * sizeof(T)};
+                file.write(reinterpret_cast<char const *>(values.data()), static_cast<std::streamsize>(entry.size));
+                position += entry.size;
+                pad_to(align_to_page(position));
+                return entry;
+            }
+
+            void finish(Header const &header) {
+                file.seekp(0);
+                file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+                file.flush();
+                if (!file) {
+                    throw std::runtime_error("Can not write snapshot");
+                }
+            }
+
+          private:
+            void pad_to(std::uint64_t offset) {
+                static constexpr std::array<char, PAGE_SIZE> zeros{};
+                file.write(zeros.data(), static_cast<std::streamsize>(offset - position));
+                position = offset;
+            }
+
+            std::ofstream file;
+            std::uint64_t position = 0;
+        };
+    }// namespace
+
+    void Delaunay::save(std::filesystem::path const &path) {
+        std::size_t const quarter_count = 4 * primary_edges.size();
+
+        // Edges are stored in id order, the quarter edges of every edge in rot order,
+        // so p_rot is implicit and only onext has to be stored
+        std::vector<std::uint32_t> onext(quarter_count);
+        std::vector<std::uint32_t> origin_indices(quarter_count);
+        std::vector<std::uint8_t> states(quarter_count);
+        for (std::size_t edge = 0; edge < primary_edges.size(); edge++) {
+            QuadEdge *quarter = primary_edges[edge];
+            for (std::size_t rotation = 0; rotation < 4; rotation++, quarter = quarter->rot()) {
+                std::size_t const id = 4 * edge + rotation;
+                onext[id] = to_index(quarter->orbit_next()->id());
+                origin_indices[id] = to_index(quarter->origin_index());
+                states[id] = static_cast<std::uint8_t>(quarter->state);
+            }
+        }
+
+        std::vector<std::uint32_t> face_vertices(faces.size());
+        for (std::size_t i = 0; i < faces.size(); i++) {
+            face_vertices[i] = to_index(faces[i]);
+        }
+
+        std::vector<std::uint32_t> face_edge_ids(face_edges.size());
+        for (std::size_t i = 0; i < face_edges.size(); i++) {
+            face_edge_ids[i] = to_index(face_edges[i]->id());
+        }
+
+        Header header{};
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.endianness = ENDIANNESS;
+        header.vertex_count = vertices.size();
+        header.edge_count = primary_edges.size();
+        header.face_count = face_edges.size();
+        header.hull_edge = hull_edge == nullptr ? NO_INDEX : to_index(hull_edge->id());
+
+        SnapshotWriter writer(path);
+        header.sections[VERTICES] = writer.write(vertices);
+        header.sections[ONEXT] = writer.write(onext);
+        header.sections[ORIGIN_INDICES] = writer.write(origin_indices);
+        header.sections[STATES] = writer.write(states);
+        header.sections[FACES] = writer.write(face_vertices);
+        header.sections[FACE_EDGES] = writer.write(face_edge_ids);
+        header.sections[CIRCUMCENTERS] = writer.write(circumcenters);
+        writer.finish(header);
+    }
+
+    auto Delaunay::load(std::filesystem::path const &path, std::pmr::memory_resource *resource) -> Delaunay {
+        return Delaunay(path, resource);
+    }
+
+    Delaunay::Delaunay(std::filesystem::path const &snapshot_path, std::pmr::memory_resource *resource) :
+        Delaunay(resource) {
+        MappedFile const file(snapshot_path);
+
+        Header header{};
+        if (file.size() < sizeof(Header)) {
+            throw std::runtime_error("Snapshot is too small");
+        }
+        std::memcpy(&header, file.data(), sizeof(Header));
+        if (header.magic != MAGIC || header.endianness != ENDIANNESS) {
+            throw std::runtime_error("File is not a snapshot of this platform");
+        }
+        if (header.version != VERSION) {
+            throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version));
+        }
+
+        // Every count is bounded by the file before it is multiplied, so a corrupt header can not wrap a section size
+        if (header.vertex_count > file.size() / sizeof(point_t) ||
+            header.edge_count > file.size() / (4 * sizeof(std::uint32_t)) ||
+            header.face_count > file.size() / (3 * sizeof(std::uint32_t))) {
+            throw std::runtime_error("Snapshot counts exceed the file");
+        }
+
+        std::uint64_t const quarter_count = 4 * header.edge_count;
+        auto const *vertex_data = file.section<point_t>(header.sections[VERTICES], header.vertex_count);
+        auto const *onext = file.section<std::uint32_t>(header.sections[ONEXT], quarter_count);
+        auto const *origin_indices = file.section<std::uint32_t>(header.sections[ORIGIN_INDICES], quarter_count);
+        auto const *states = file.section<std::uint8_t>(header.sections[STATES], quarter_count);
+        auto const *face_vertices = file.section<std::uint32_t>(header.sections[FACES], 3 * header.face_count);
+        auto const *face_edge_ids = file.section<std::uint32_t>(header.sections[FACE_EDGES], header.face_count);
+        auto const *circumcenter_data = file.section<point_t>(header.sections[CIRCUMCENTERS], header.face_count);
+
+        vertices.assign(vertex_data, vertex_data + header.vertex_count);
+        circumcenters.assign(circumcenter_data, circumcenter_data + header.face_count);
+        faces.assign(face_vertices, face_vertices + 3 * header.face_count);
+        for (std::size_t vertex : faces) {
+            if (vertex >= header.vertex_count) {
+                throw std::runtime_error("Snapshot references a vertex out of bounds");
+            }
+        }
+
+        // Create all edges first, so the links can be resolved by id afterwards
+        primary_edges.reserve(header.edge_count);
+        primary_sym_edges.reserve(header.edge_count);
+        dual_edges.reserve(header.edge_count);
+        dual_sym_edges.reserve(header.edge_count);
+        point_t const infinity(std::numeric_limits<scalar_t>::infinity(), std::numeric_limits<scalar_t>::infinity());
+        for (std::uint64_t edge = 0; edge < header.edge_count; edge++) {
+            auto *primary = edge_pool.allocate(infinity, QuadEdge::INVALID_INDEX, infinity, QuadEdge::INVALID_INDEX);
+            primary_edges.push_back(primary);
+            dual_edges.push_back(primary + 1);
+            primary_sym_edges.push_back(primary + 2);
+            dual_sym_edges.push_back(primary + 3);
+        }
+
+        auto quarter_edge = [this, quarter_count](std::uint64_t id) -> QuadEdge * {
+            if (id >= quarter_count) {
+                throw std::runtime_error("Snapshot references an edge out of bounds");
+            }
+            return primary_edges[id / 4] + id % 4;
+        };
+        auto primary_quarter_edge = [&quarter_edge](std::uint64_t id) -> QuadEdge * {
+            if (id % 2 != 0) {
+                throw std::runtime_error("Snapshot references a dual edge where a primary one is expected");
+            }
+            return quarter_edge(id);
+        };
+
+        for (std::uint64_t id = 0; id < quarter_count; id++) {
+            QuadEdge *quarter = quarter_edge(id);
+            quarter->m_id = id;
+            quarter->p_rot = primary_edges[id / 4] + (id + 1) % 4;
+            quarter->p_onext = quarter_edge(onext[id]);
+            if (states[id] > static_cast<std::uint8_t>(EdgeState::PROCESSED)) {
+                throw std::runtime_error("Snapshot contains an unknown edge state");
+            }
+            quarter->state = static_cast<EdgeState>(states[id]);
+
+            // Primary quarter edges start at a vertex, dual ones at a face (the circumcenter)
+            std::size_t const index = from_index(origin_indices[id]);
+            std::size_t const bound = id % 2 == 0 ? header.vertex_count : header.face_count;
+            if (index != QuadEdge::INVALID_INDEX && index >= bound) {
+                throw std::runtime_error("Snapshot references a vertex out of bounds");
+            }
+            quarter->m_origin_index = index;
+            if (index != QuadEdge::INVALID_INDEX) {
+                quarter->m_origin = id % 2 == 0 ? vertices[index] : circumcenters[index];
+            }
+        }
+
+        face_edges.reserve(header.face_count);
+        for (std::uint64_t face = 0; face < header.face_count; face++) {
+            face_edges.push_back(primary_quarter_edge(face_edge_ids[face]));
+        }
+        if (header.hull_edge != NO_INDEX) {
+            hull_edge = primary_quarter_edge(header.hull_edge);
+        }
+    }
+}// namespace delaunay
@@ -0,0 +1,434 @@
+#include "delaunay/sweep_hull.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace delaunay {
+    namespace {
+        auto squared_distance(point_t const &a, point_t const &b) -> scalar_t {
+            scalar_t const dx = a.x - b.x;
+            scalar_t const dy = a.y - b.y;
+            return dx * dx + dy * dy;
+        }
+
+        /**
+         * Squared radius of the circumcircle, infinite for collinear points
+         */
+        auto squared_circumradius(point_t const &a, point_t const &b, point_t const &c) -> scalar_t {
+            if (!point_t::counter_clock_wise(a, b, c) && !point_t::counter_clock_wise(a, c, b)) {
+                return std::numeric_limits<scalar_t>::infinity();
+            }
+            return squared_distance(point_t::circumcenter(a, b, c), a);
+        }
+    }// namespace
+
+    SweepHull::HalfEdge::HalfEdge(SweepHull const *mesh, std::uint32_t id) : mesh(mesh), edge_id(id) {}
+
+    auto SweepHull::HalfEdge::id() const -> std::uint32_t {
+        return edge_id;
+    }
+
+    auto SweepHull::HalfEdge::origin() const -> point_t const & {
+        return mesh->vertices[origin_index()];
+    }
+
+    auto SweepHull::HalfEdge::destination() const -> point_t const & {
+        return mesh->vertices[destination_index()];
+    }
+
+    auto SweepHull::HalfEdge::origin_index() const -> std::size_t {
+        if (is_outer()) {
+            return sym().destination_index();
+        }
+        return mesh->triangles[edge_id];
+    }
+
+    auto SweepHull::HalfEdge::destination_index() const -> std::size_t {
+        if (is_outer()) {
+            return sym().origin_index();
+        }
+        return mesh->triangles[left_face_next().edge_id];
+    }
+
+    auto SweepHull::HalfEdge::sym() const -> HalfEdge {
+        auto const size = static_cast<std::uint32_t>(mesh->triangles.size());
+        if (is_outer()) {
+            return {mesh, edge_id - size};
+        }
+
+        // Hull edges have their opposite in the outer face
+        std::uint32_t const opposite = mesh->half_edges[edge_id];
+        return {mesh, opposite == INVALID_INDEX ? edge_id + size : opposite};
+    }
+
+    auto SweepHull::HalfEdge::orbit_next() const -> HalfEdge {
+        return left_face_prev().sym();
+    }
+
+    auto SweepHull::HalfEdge::orbit_prev() const -> HalfEdge {
+        return sym().left_face_next();
+    }
+
+    auto SweepHull::HalfEdge::left_face_next() const -> HalfEdge {
+        if (is_outer()) {
+            // The outer face runs clockwise along the hull, continuing with the hull edge ending at the destination
+            std::uint32_t const destination = mesh->hull_prev[destination_index()];
+            return HalfEdge(mesh, mesh->hull_edges[destination]).sym();
+        }
+        return {mesh, edge_id - edge_id % 3 + (edge_id + 1) % 3};
+    }
+
+    auto SweepHull::HalfEdge::left_face_prev() const -> HalfEdge {
+        if (is_outer()) {
+            return HalfEdge(mesh, mesh->hull_edges[origin_index()]).sym();
+        }
+        return {mesh, edge_id - edge_id % 3 + (edge_id + 2) % 3};
+    }
+
+    auto SweepHull::HalfEdge::left_face_index() const -> std::size_t {
+        // Same sentinel as QuadEdge::INVALID_INDEX, so generic code compares against either
+        if (is_outer()) {
+            return std::numeric_limits<std::size_t>::max();
+        }
+        return edge_id / 3;
+    }
+
+    auto SweepHull::HalfEdge::is_left_face_triangle() const -> bool {
+        return !is_outer();
+    }
+
+    auto SweepHull::HalfEdge::is_deleted() const -> bool {
+        return false;
+    }
+
+    auto SweepHull::HalfEdge::operator->() const -> HalfEdge const * {
+        return this;
+    }
+
+    auto SweepHull::HalfEdge::is_outer() const -> bool {
+        return edge_id >= mesh->triangles.size();
+    }
+
+    SweepHull::SweepHull(std::pmr::memory_resource *resource) :
+        vertices(resource),
+        triangles(resource),
+        half_edges(resource),
+        hull(resource),
+        hull_next(resource),
+        hull_prev(resource),
+        hull_edges(resource),
+        hull_hash(resource),
+        edge_stack(resource),
+        center(0, 0) {}
+
+    auto SweepHull::triangulate(std::span<point_t const> points, std::pmr::memory_resource *resource) -> SweepHull {
+        if (points.size() >= INVALID_INDEX) {
+            throw std::runtime_error("Too many points for 32 bit indices");
+        }
+
+        SweepHull triangulation(resource);
+        triangulation.vertices.assign(points.begin(), points.end());
+        triangulation.build();
+        return triangulation;
+    }
+
+    auto SweepHull::get_vertices() const -> std::span<point_t const> {
+        return vertices;
+    }
+
+    auto SweepHull::get_triangles() const -> std::span<std::uint32_t const> {
+        return triangles;
+    }
+
+    auto SweepHull::get_half_edges() const -> std::span<std::uint32_t const> {
+        return half_edges;
+    }
+
+    auto SweepHull::get_hull() const -> std::span<std::uint32_t const> {
+        return hull;
+    }
+
+    auto SweepHull::get_primary_edges() const -> std::vector<HalfEdge> {
+        std::vector<HalfEdge> edges;
+        edges.reserve(half_edges.size() / 2 + hull.size());
+        for (std::uint32_t edge = 0; edge < half_edges.size(); edge++) {
+            if (half_edges[edge] == INVALID_INDEX || edge < half_edges[edge]) {
+                edges.emplace_back(this, edge);
+            }
+        }
+        return edges;
+    }
+
+    auto SweepHull::get_convex_hull() const -> std::vector<HalfEdge> {
+        std::vector<HalfEdge> edges;
+        if (triangles.empty()) {
+            return edges;
+        }
+
+        edges.reserve(hull.size());
+        for (std::uint32_t vertex : hull) {
+            edges.emplace_back(this, hull_edges[vertex]);
+        }
+        return edges;
+    }
+
+    void SweepHull::build() {
+        std::pmr::memory_resource *resource = vertices.get_allocator().resource();
+        auto const count = static_cast<std::uint32_t>(vertices.size());
+        if (count == 0) {
+            return;
+        }
+
+        // Seed triangle: the point closest to the center of the bounding box, its closest neighbour
+        // and the point forming the smallest circumcircle with both
+        point_t min = vertices.front();
+        point_t max = vertices.front();
+        for (auto const &vertex : vertices) {
+            min = point_t(std::min(min.x, vertex.x), std::min(min.y, vertex.y));
+            max = point_t(std::max(max.x, vertex.x), std::max(max.y, vertex.y));
+        }
+        point_t const box_center((min.x + max.x) / 2, (min.y + max.y) / 2);
+
+        std::uint32_t i0 = 0;
+        for (std::uint32_t i = 1; i < count; i++) {
+            if (squared_distance(vertices[i], box_center) < squared_distance(vertices[i0], box_center)) {
+                i0 = i;
+            }
+        }
+
+        std::uint32_t i1 = INVALID_INDEX;
+        scalar_t closest = std::numeric_limits<scalar_t>::infinity();
+        for (std::uint32_t i = 0; i < count; i++) {
+            scalar_t const distance = squared_distance(vertices[i], vertices[i0]);
+            if (distance > 0 && distance < closest) {
+                i1 = i;
+                closest = distance;
+            }
+        }
+
+        std::uint32_t i2 = INVALID_INDEX;
+        scalar_t smallest = std::numeric_limits<scalar_t>::infinity();
+        for (std::uint32_t i = 0; i1 != INVALID_INDEX && i < count; i++) {
+            scalar_t const radius = squared_circumradius(vertices[i0], vertices[i1], vertices[i]);
+            if (radius < smallest) {
+                i2 = i;
+                smallest = radius;
+            }
+        }
+
+        // All points are collinear (or equal), there are no triangles and the hull is the sorted line
+        if (i2 == INVALID_INDEX) {
+            hull.resize(count);
+            for (std::uint32_t i = 0; i < count; i++) {
+                hull[i] = i;
+            }
+            std::sort(hull.begin(), hull.end(), [this](std::uint32_t a, std::uint32_t b) {
+                return vertices[a].x < vertices[b].x || (vertices[a].x == vertices[b].x && vertices[a].y < vertices[b].y);
+            });
+            hull.erase(std::unique(hull.begin(), hull.end(),
+                                   [this](std::uint32_t a, std::uint32_t b) { return vertices[a] == vertices[b]; }),
+                       hull.end());
+            return;
+        }
+
+        if (!point_t::counter_clock_wise(vertices[i0], vertices[i1], vertices[i2])) {
+            std::swap(i1, i2);
+        }
+        center = point_t::circumcenter(vertices[i0], vertices[i1], vertices[i2]);
+
+        // Points are inserted by distance to the seed circle, so every point lies outside the current hull
+        std::pmr::vector<scalar_t> distances(count, 0, resource);
+        std::pmr::vector<std::uint32_t> order(count, 0, resource);
+        parallel::parallel_for(count, [this, &distances, &order](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                distances[i] = squared_distance(vertices[i], center);
+                order[i] = static_cast<std::uint32_t>(i);
+            }
+        });
+        parallel::sort(order.begin(), order.end(), [&distances](std::uint32_t a, std::uint32_t b) {
+            return distances[a] < distances[b] || (distances[a] == distances[b] && a < b);
+        });
+
+        // A triangulation of n >= 3 points has at most 2n - 5 triangles
+        std::size_t const max_triangles = 2 * std::size_t{count} - 5;
+        triangles.reserve(3 * max_triangles);
+        half_edges.reserve(3 * max_triangles);
+
+        hull_next.assign(count, INVALID_INDEX);
+        hull_prev.assign(count, INVALID_INDEX);
+        hull_edges.assign(count, INVALID_INDEX);
+        hull_hash.assign(static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count)))), INVALID_INDEX);
+
+        hull_next[i0] = i1;
+        hull_next[i1] = i2;
+        hull_next[i2] = i0;
+        hull_prev[i0] = i2;
+        hull_prev[i1] = i0;
+        hull_prev[i2] = i1;
+        std::ignore = add_triangle(i0, i1, i2, INVALID_INDEX, INVALID_INDEX, INVALID_INDEX);
+        for (std::uint32_t seed : {i0, i1, i2}) {
+            hull_hash[hash_key(vertices[seed])] = seed;
+        }
+
+        // A point sees a hull edge if it lies on its outer (right) side
+        auto visible = [this](point_t const &point, std::uint32_t from, std::uint32_t to) {
+            return point_t::counter_clock_wise(vertices[to], vertices[from], point);
+        };
+
+        std::uint32_t hull_start = i0;
+        for (std::size_t k = 0; k < count; k++) {
+            std::uint32_t const i = order[k];
+            point_t const &point = vertices[i];
+            if (i == i0 || i == i1 || i == i2 || (k > 0 && point == vertices[order[k - 1]])) {
+                continue;
+            }
+
+            // Hull vertex of a similar angle, skipping vertices that left the hull
+            std::size_t const key = hash_key(point);
+            std::uint32_t start = INVALID_INDEX;
+            for (std::size_t j = 0; j < hull_hash.size(); j++) {
+                start = hull_hash[(key + j) % hull_hash.size()];
+                if (start != INVALID_INDEX && start != hull_next[start]) {
+                    break;
+                }
+            }
+
+            // First visible hull edge, none if the predicates place the point inside (e.g. a duplicate)
+            start = hull_prev[start];
+            std::uint32_t e = start;
+            while (!visible(point, e, hull_next[e])) {
+                e = hull_next[e];
+                if (e == start) {
+                    e = INVALID_INDEX;
+                    break;
+                }
+            }
+            if (e == INVALID_INDEX) {
+                continue;
+            }
+
+            std::uint32_t t = add_triangle(e, i, hull_next[e], INVALID_INDEX, INVALID_INDEX, hull_edges[e]);
+            legalize(t + 2);
+
+            // Connect to the following visible hull edges
+            std::uint32_t next = hull_next[e];
+            for (std::uint32_t q = hull_next[next]; visible(point, next, q); q = hull_next[next]) {
+                t = add_triangle(next, i, q, hull_edges[i], INVALID_INDEX, hull_edges[next]);
+                legalize(t + 2);
+                hull_next[next] = next;
+                next = q;
+            }
+
+            // And to the preceding ones, if the walk started at a visible edge
+            if (e == start) {
+                for (std::uint32_t q = hull_prev[e]; visible(point, q, e); q = hull_prev[e]) {
+                    t = add_triangle(q, i, e, INVALID_INDEX, hull_edges[e], hull_edges[q]);
+                    legalize(t + 2);
+                    hull_next[e] = e;
+                    e = q;
+                }
+            }
+
+            hull_start = e;
+            hull_prev[i] = e;
+            hull_next[e] = i;
+            hull_prev[next] = i;
+            hull_next[i] = next;
+            hull_hash[key] = i;
+            hull_hash[hash_key(vertices[e])] = e;
+        }
+
+        std::uint32_t vertex = hull_start;
+        do {
+            hull.push_back(vertex);
+            vertex = hull_next[vertex];
+        } while (vertex != hull_start);
+    }
+
+    auto SweepHull::add_triangle(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t ab,
+                                 std::uint32_t bc, std::uint32_t ca) -> std::uint32_t {
+        auto const t = static_cast<std::uint32_t>(triangles.size());
+        triangles.insert(triangles.end(), {a, b, c});
+        half_edges.resize(t + 3);
+        link(t, ab);
+        link(t + 1, bc);
+        link(t + 2, ca);
+        return t;
+    }
+
+    void SweepHull::link(std::uint32_t a, std::uint32_t b) {
+        half_edges[a] = b;
+        if (b == INVALID_INDEX) {
+            // A half edge without opposite is on the hull, flips can move it to a different slot
+            hull_edges[triangles[a]] = a;
+        } else {
+            half_edges[b] = a;
+        }
+    }
+
+    void SweepHull::legalize(std::uint32_t edge) {
+        edge_stack.clear();
+        edge_stack.push_back(edge);
+
+        while (!edge_stack.empty()) {
+            std::uint32_t const a = edge_stack.back();
+            edge_stack.pop_back();
+            std::uint32_t const b = half_edges[a];
+            if (b == INVALID_INDEX) {
+                continue;
+            }
+
+            // a runs x -> y in the triangle (x, y, pa), pa being the new vertex, b runs y -> x in (y, x, pb)
+            std::uint32_t const a0 = a - a % 3;
+            std::uint32_t const b0 = b - b % 3;
+            std::uint32_t const an = a0 + (a + 1) % 3;
+            std::uint32_t const ap = a0 + (a + 2) % 3;
+            std::uint32_t const bn = b0 + (b + 1) % 3;
+            std::uint32_t const bp = b0 + (b + 2) % 3;
+
+            point_t const &x = vertices[triangles[a]];
+            point_t const &y = vertices[triangles[an]];
+            point_t const &pa = vertices[triangles[ap]];
+            point_t const &pb = vertices[triangles[bp]];
+            if (!point_t::in_circle(x, y, pa, pb)) {
+                continue;
+            }
+
+            // The predicates are not exact, so only convex quadrilaterals are flipped
+            if (!point_t::counter_clock_wise(pa, x, pb) || !point_t::counter_clock_wise(pb, y, pa)) {
+                continue;
+            }
+
+            // Flip to the triangles (pb, y, pa) in the slots of a and (pa, x, pb) in the slots of b
+            std::uint32_t const opposite_bp = half_edges[bp];
+            std::uint32_t const opposite_ap = half_edges[ap];
+            triangles[a] = triangles[bp];
+            triangles[b] = triangles[ap];
+            link(a, opposite_bp);
+            link(b, opposite_ap);
+            link(ap, bp);
+
+            // The edges opposite of the new vertex may no longer be locally Delaunay
+            edge_stack.push_back(a);
+            edge_stack.push_back(bn);
+        }
+    }
+
+    auto SweepHull::hash_key(point_t const &point) const -> std::size_t {
+        scalar_t const dx = point.x - center.x;
+        scalar_t const dy = point.y - center.y;
+        scalar_t const length = std::abs(dx) + std::abs(dy);
+        if (length <= 0) {
+            return 0;
+        }
+
+        // Pseudo angle in [0, 1], monotone in the angle around the center
+        scalar_t const p = dx / length;
+        scalar_t const angle = (dy > 0 ? 3 - p : 1 + p) / 4;
+        return static_cast<std::size_t>(std::floor(angle * static_cast<scalar_t>(hull_hash.size()))) % hull_hash.size();
+    }
+}// namespace delaunay
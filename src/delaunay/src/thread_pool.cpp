@@ -0,0 +1,103 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace delaunay {
+    namespace {
+        /**
+         * Set on the workers, to run nested jobs sequentially instead of waiting for the pool
+         */
+        thread_local bool is_pool_worker = false;
+    }// namespace
+
+    auto ThreadPool::instance() -> ThreadPool & {
+        static ThreadPool pool(std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+        return pool;
+    }
+
+    ThreadPool::ThreadPool(std::size_t threads) {
+        for (std::size_t i = 1; i < threads; i++) {
+            workers.emplace_back([this]() { work(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard const lock(state_mutex);
+            stopping = true;
+        }
+        job_available.notify_all();
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    auto ThreadPool::size() const -> std::size_t {
+        return workers.size() + 1;
+    }
+
+    void ThreadPool::run(std::size_t tasks, std::function<void(std::size_t)> const &fn) {
+        if (tasks == 0) {
+            return;
+        }
+
+        if (tasks == 1 || workers.empty() || is_pool_worker) {
+            for (std::size_t task = 0; task < tasks; task++) {
+                fn(task);
+            }
+            return;
+        }
+
+        std::lock_guard const job_lock(job_mutex);
+        {
+            std::lock_guard const lock(state_mutex);
+            job = &fn;
+            job_tasks = tasks;
+            next_task = 0;
+            job_generation++;
+        }
+        job_available.notify_all();
+
+        // The calling thread works as well, running nested jobs sequentially
+        is_pool_worker = true;
+        process_tasks();
+        is_pool_worker = false;
+
+        // Wait for workers still finishing their last task
+        std::unique_lock lock(state_mutex);
+        job_done.wait(lock, [this]() { return busy_workers == 0; });
+        job = nullptr;
+    }
+
+    void ThreadPool::process_tasks() {
+        for (std::size_t task = next_task++; task < job_tasks; task = next_task++) {
+            (*job)(task);
+        }
+    }
+
+    void ThreadPool::work() {
+        is_pool_worker = true;
+        std::size_t seen_generation = 0;
+
+        while (true) {
+            {
+                std::unique_lock lock(state_mutex);
+                job_available.wait(lock, [&]() { return stopping || (job != nullptr && job_generation != seen_generation); });
+                if (stopping) {
+                    return;
+                }
+                seen_generation = job_generation;
+                busy_workers++;
+            }
+
+            process_tasks();
+
+            {
+                std::lock_guard const lock(state_mutex);
+                busy_workers--;
+            }
+            job_done.notify_one();
+        }
+    }
+}// namespace delaunay
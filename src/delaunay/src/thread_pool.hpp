@@ -0,0 +1,91 @@
+#ifndef DELAUNAY_THREAD_POOL_HPP
+#define DELAUNAY_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace delaunay {
+    /**
+     * Fixed set of worker threads running the parallel passes of the library,
+     * so they do not pay for starting threads on every call.
+     *
+     * One job runs at a time. The calling thread works on the job as well and
+     * a job started from inside a worker runs sequentially on that worker.
+     */
+    class ThreadPool {
+      public:
+        /**
+         * The pool shared by the whole library, with one thread per hardware thread
+         * @return shared pool
+         */
+        static auto instance() -> ThreadPool &;
+
+        /**
+         * Constructor, starts the workers
+         * @param threads number of threads working on a job, including the calling thread
+         */
+        explicit ThreadPool(std::size_t threads);
+
+        /**
+         * Destructor, stops and joins the workers
+         */
+        ~ThreadPool();
+
+        /**
+         * Number of threads working on a job, including the calling thread
+         * @return number of threads
+         */
+        [[nodiscard]] auto size() const -> std::size_t;
+
+        /**
+         * Calls fn(task) for every task in [0, tasks) and blocks until all tasks are done
+         * @param tasks number of tasks
+         * @param fn function called with the task index, from any thread of the pool
+         */
+        void run(std::size_t tasks, std::function<void(std::size_t)> const &fn);
+
+        ThreadPool(ThreadPool const &other) = delete;
+        ThreadPool(ThreadPool &&other) = delete;
+        auto operator=(ThreadPool const &other) -> ThreadPool & = delete;
+        auto operator=(ThreadPool &&other) -> ThreadPool & = delete;
+
+      private:
+        /**
+         * Main loop of a worker
+         */
+        void work();
+
+        /**
+         * Takes tasks of the current job until none are left
+         */
+        void process_tasks();
+
+        std::vector<std::thread> workers;
+
+        /**
+         * Serialises jobs
+         */
+        std::mutex job_mutex;
+
+        /**
+         * Protects the job state below
+         */
+        std::mutex state_mutex;
+        std::condition_variable job_available;
+        std::condition_variable job_done;
+
+        std::function<void(std::size_t)> const *job = nullptr;
+        std::size_t job_tasks = 0;
+        std::size_t job_generation = 0;
+        std::size_t busy_workers = 0;
+        std::atomic<std::size_t> next_task{0};
+        bool stopping = false;
+    };
+}// namespace delaunay
+
+#endif// DELAUNAY_THREAD_POOL_HPP
@@ -0,0 +1,324 @@
+#include "delaunay/delaunay.hpp"
+#include "hole_triangulation.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+
+namespace delaunay {
+    auto Delaunay::remove_vertices(std::span<std::size_t const> removed) -> bool {
+        if (removed.empty()) {
+            return true;
+        }
+
+        std::pmr::memory_resource *resource = memory_resource();
+        std::pmr::vector<char> is_removed(vertices.size(), 0, resource);
+        for (std::size_t vertex : removed) {
+            if (vertex >= vertices.size() || is_removed[vertex] != 0) {
+                throw std::invalid_argument("Removed vertices must be valid and distinct");
+            }
+            is_removed[vertex] = 1;
+        }
+
+        // One edge leaving every removed vertex, found in the faces so only their flat array is scanned
+        std::pmr::vector<QuadEdge *> edges(vertices.size(), nullptr, resource);
+        for (std::size_t face = 0; face < face_edges.size(); face++) {
+            QuadEdge *edge = face_edges[face];
+            for (std::size_t corner = 0; corner < 3; corner++) {
+                if (is_removed[faces[3 * face + corner]] != 0) {
+                    edges[faces[3 * face + corner]] = edge;
+                }
+                edge = edge->left_face_next();
+            }
+        }
+
+        std::pmr::vector<QuadEdge *> leaving(resource);
+        leaving.reserve(removed.size());
+        for (std::size_t vertex : removed) {
+            if (edges[vertex] == nullptr) {
+                throw std::invalid_argument("Removed vertices must have edges");
+            }
+            leaving.push_back(edges[vertex]);
+        }
+
+        bool const local = detach_vertices(leaving);
+        compact_vertices();
+        return local;
+    }
+
+    auto Delaunay::detach_vertices(std::span<QuadEdge *const> leaving) -> bool {
+        if (leaving.empty()) {
+            return true;
+        }
+
+        // The holes must not share vertices, so they can be filled in parallel without touching the same ring:
+        // the removed vertices and their rings are all distinct.
+        // The faces of every hole are numbered consecutively in old_faces, starting at offsets[i]
+        std::pmr::memory_resource *resource = memory_resource();
+        std::pmr::vector<std::size_t> involved(resource);
+        std::pmr::vector<std::size_t> old_faces(resource);
+        std::pmr::vector<std::size_t> offsets(resource);
+        offsets.reserve(leaving.size() + 1);
+        for (QuadEdge *edge : leaving) {
+            if (edge == nullptr || edge->state == EdgeState::DELETED) {
+                throw std::invalid_argument("Removed vertices must have edges");
+            }
+            offsets.push_back(old_faces.size());
+            involved.push_back(edge->origin_index());
+            QuadEdge *current = edge;
+            do {
+                if (current->left_face_index() == QuadEdge::INVALID_INDEX) {
+                    throw std::invalid_argument("Hull vertices can not be removed");
+                }
+                involved.push_back(current->destination_index());
+                old_faces.push_back(current->left_face_index());
+                current = current->orbit_next();
+            } while (current != edge);
+        }
+        offsets.push_back(old_faces.size());
+        std::sort(involved.begin(), involved.end());
+        if (std::adjacent_find(involved.begin(), involved.end()) != involved.end()) {
+            throw std::invalid_argument("Removed vertices must be distinct and must not share neighbours");
+        }
+        for (std::size_t vertex : involved) {
+            touch_vertex(vertex);
+        }
+
+        std::atomic<bool> delaunay{true};
+        std::pmr::vector<QuadEdge *> new_faces(old_faces.size(), nullptr, resource);
+        std::size_t const detached = detached_vertices.size();
+        detached_vertices.resize(detached + leaving.size());
+        parallel::parallel_for(leaving.size(), [&](std::size_t begin, std::size_t end) {
+            std::pmr::vector<QuadEdge *> spokes(resource);
+            std::pmr::vector<QuadEdge *> outgoing(resource);
+            std::pmr::vector<point_t> polygon(resource);
+            std::pmr::vector<std::size_t> ring(resource);
+            std::pmr::vector<std::array<std::size_t, 3>> ears(resource);
+
+            for (std::size_t i = begin; i < end; i++) {
+                detached_vertices[detached + i] = leaving[i]->origin_index();
+                std::span<QuadEdge *> const hole_faces(new_faces.data() + offsets[i], offsets[i + 1] - offsets[i]);
+                if (!remove_vertex(leaving[i], hole_faces, spokes, outgoing, polygon, ring, ears)) {
+                    delaunay = false;
+                }
+            }
+        });
+
+        if (delaunay) {
+            replace_faces(old_faces, offsets, new_faces);
+            return true;
+        }
+
+        // Ears the predicates could not place as Delaunay triangles are repaired by flips,
+        // if these cycle the compacted vertices are triangulated again.
+        // The flips may have changed triangles beyond the holes
+        bool const repaired = restore_delaunay();
+        update_vornoi_graph();
+        if (!repaired) {
+            compact_vertices();
+            rebuild();
+        }
+        return false;
+    }
+
+    void Delaunay::compact_vertices() {
+        if (detached_vertices.empty()) {
+            return;
+        }
+
+        // Drop the detached vertices, the remaining ones keep their (sorted) order
+        std::pmr::memory_resource *resource = memory_resource();
+        std::pmr::vector<std::size_t> renumbering(vertices.size(), 0, resource);
+        for (std::size_t vertex : detached_vertices) {
+            renumbering[vertex] = QuadEdge::INVALID_INDEX;
+        }
+        std::pmr::vector<std::size_t> kept(resource);
+        kept.reserve(vertices.size() - detached_vertices.size());
+        for (std::size_t vertex = 0; vertex < vertices.size(); vertex++) {
+            if (renumbering[vertex] != QuadEdge::INVALID_INDEX) {
+                renumbering[vertex] = kept.size();
+                vertices[kept.size()] = vertices[vertex];
+                if (!vertex_origins.empty()) {
+                    vertex_origins[kept.size()] = vertex_origins[vertex];
+                }
+                kept.push_back(vertex);
+            }
+        }
+        vertices.erase(vertices.begin() + static_cast<std::ptrdiff_t>(kept.size()), vertices.end());
+        if (!vertex_origins.empty()) {
+            vertex_origins.resize(kept.size());
+        }
+        for (std::size_t &vertex : input_vertices) {
+            if (vertex != QuadEdge::INVALID_INDEX) {
+                vertex = renumbering[vertex];
+            }
+        }
+        detached_vertices.clear();
+
+        // Deleted edges are dropped from the lists, so they do not pile up over repeated removals.
+        // Their storage stays in the pool until optimize_layout() or a rebuild relays the edges
+        std::size_t live = 0;
+        for (std::size_t i = 0; i < primary_edges.size(); i++) {
+            if (primary_edges[i]->state != EdgeState::DELETED) {
+                primary_edges[live] = primary_edges[i];
+                dual_edges[live] = dual_edges[i];
+                primary_sym_edges[live] = primary_sym_edges[i];
+                dual_sym_edges[live] = dual_sym_edges[i];
+                live++;
+            }
+        }
+        for (auto *edges : {&primary_edges, &dual_edges, &primary_sym_edges, &dual_sym_edges}) {
+            edges->resize(live);
+        }
+        parallel::parallel_for(live, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                // The quarter edges are stored in rot order, see make_edge()
+                for (std::size_t r = 0; r < 4; r++) {
+                    primary_edges[i][r].m_id = 4 * i + r;
+                }
+                primary_edges[i]->m_origin_index = renumbering[primary_edges[i]->m_origin_index];
+                primary_sym_edges[i]->m_origin_index = renumbering[primary_sym_edges[i]->m_origin_index];
+            }
+        });
+        for (std::size_t &vertex : faces) {
+            vertex = renumbering[vertex];
+        }
+
+        remap_vertex_attributes(kept, {});
+        renumber_changes(renumbering);
+    }
+
+    auto Delaunay::get_detached_vertices() -> std::span<std::size_t const> {
+        return detached_vertices;
+    }
+
+    void Delaunay::replace_faces(std::span<std::size_t const> old_faces, std::span<std::size_t const> offsets,
+                                 std::span<QuadEdge *const> new_faces) {
+        if (changes_tracked) {
+            previous_faces.assign(faces.begin(), faces.end());
+        }
+
+        // A hole of k triangles is filled by k - 2, which take the first ids of the old ones
+        std::size_t const holes = offsets.size() - 1;
+        parallel::parallel_for(holes, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t hole = begin; hole < end; hole++) {
+                for (std::size_t i = offsets[hole]; i + 2 < offsets[hole + 1]; i++) {
+                    set_face(old_faces[i], new_faces[i]);
+                }
+            }
+        });
+
+        // The last faces move to the two ids every hole freed, so the ids stay contiguous
+        std::pmr::vector<std::size_t> freed(memory_resource());
+        freed.reserve(2 * holes);
+        for (std::size_t hole = 0; hole < holes; hole++) {
+            freed.push_back(old_faces[offsets[hole + 1] - 2]);
+            freed.push_back(old_faces[offsets[hole + 1] - 1]);
+        }
+        std::sort(freed.begin(), freed.end());
+
+        std::size_t const face_count = face_edges.size() - freed.size();
+        std::size_t source = face_edges.size();
+        for (std::size_t face : freed) {
+            if (face >= face_count) {
+                break;
+            }
+            do {
+                source--;
+            } while (std::binary_search(freed.begin(), freed.end(), source));
+
+            face_edges[face] = face_edges[source];
+            std::copy_n(faces.begin() + static_cast<std::ptrdiff_t>(3 * source), 3,
+                        faces.begin() + static_cast<std::ptrdiff_t>(3 * face));
+            circumcenters[face] = circumcenters[source];
+            QuadEdge *current = face_edges[face];
+            for (int i = 0; i < 3; i++) {
+                current->inv_rot()->m_origin_index = face;
+                current = current->left_face_next();
+            }
+        }
+        face_edges.resize(face_count);
+        faces.resize(3 * face_count);
+        circumcenters.erase(circumcenters.begin() + static_cast<std::ptrdiff_t>(face_count), circumcenters.end());
+        face_areas.clear();
+
+        record_changes({}, false);
+    }
+
+    void Delaunay::set_face(std::size_t face, QuadEdge *edge) {
+        face_edges[face] = edge;
+        QuadEdge *current = edge;
+        for (int i = 0; i < 3; i++) {
+            faces[3 * face + i] = current->origin_index();
+            current = current->left_face_next();
+        }
+        circumcenters[face] = point_t::circumcenter(vertices[faces[3 * face]], vertices[faces[3 * face + 1]],
+                                                    vertices[faces[3 * face + 2]]);
+
+        // Like calculate_vornoi_graph(), the dual edges point out of the face
+        for (int i = 0; i < 3; i++) {
+            QuadEdge *dual = current->inv_rot();
+            dual->m_origin_index = face;
+            dual->m_origin = circumcenters[face];
+            dual->state = EdgeState::INITIALIZED;
+            current->state = EdgeState::PROCESSED;
+            current = current->left_face_next();
+        }
+    }
+
+    auto Delaunay::remove_vertex(QuadEdge *edge, std::span<QuadEdge *> new_faces,
+                                 std::pmr::vector<QuadEdge *> &spokes, std::pmr::vector<QuadEdge *> &outgoing,
+                                 std::pmr::vector<point_t> &polygon, std::pmr::vector<std::size_t> &ring,
+                                 std::pmr::vector<std::array<std::size_t, 3>> &ears) -> bool {
+        // The left face of every spoke is the triangle with the next spoke, its next edge borders the hole
+        spokes.clear();
+        outgoing.clear();
+        polygon.clear();
+        QuadEdge *current = edge;
+        do {
+            spokes.push_back(current);
+            outgoing.push_back(current->left_face_next());
+            polygon.push_back(current->destination());
+            current = current->orbit_next();
+        } while (current != edge);
+
+        // The deleted edges belong to no face, the reused ones are numbered with their new faces
+        point_t const infinity(std::numeric_limits<scalar_t>::infinity(), std::numeric_limits<scalar_t>::infinity());
+        for (QuadEdge *spoke : spokes) {
+            delete_edge(spoke);
+            for (QuadEdge *dual : {spoke->rot(), spoke->inv_rot()}) {
+                dual->m_origin = infinity;
+                dual->m_origin_index = QuadEdge::INVALID_INDEX;
+                dual->state = EdgeState::DELETED;
+            }
+        }
+
+        // Every ear but the last is cut off by one of the deleted edges, from its third to its first vertex,
+        // which has the ear on its left
+        bool const delaunay = triangulate_hole(polygon, ring, ears);
+        for (std::size_t i = 0; i + 1 < ears.size(); i++) {
+            auto const [first, second, third] = ears[i];
+            QuadEdge *diagonal = spokes[i];
+            reconnect_edge(diagonal, outgoing[second], outgoing[first]);
+            outgoing[first] = diagonal->sym();
+            new_faces[i] = diagonal;
+        }
+        new_faces[ears.size() - 1] = outgoing[ears.back()[0]];
+        return delaunay;
+    }
+
+    void Delaunay::reconnect_edge(QuadEdge *edge, QuadEdge *a, QuadEdge *b) {
+        edge->m_origin_index = a->destination_index();
+        edge->m_origin = a->destination();
+        edge->sym()->m_origin_index = b->origin_index();
+        edge->sym()->m_origin = b->origin();
+        edge->state = EdgeState::INITIALIZED;
+        edge->sym()->state = EdgeState::INITIALIZED;
+
+        splice_edges(edge, a->left_face_next());
+        splice_edges(edge->sym(), b);
+    }
+}// namespace delaunay
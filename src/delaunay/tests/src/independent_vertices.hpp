@@ -0,0 +1,47 @@
+#ifndef DELAUNAY_TESTS_INDEPENDENT_VERTICES_HPP
+#define DELAUNAY_TESTS_INDEPENDENT_VERTICES_HPP
+
+#include "delaunay/delaunay.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Every interior vertex with the lowest index among its neighbours, which makes them an independent set
+ * that Delaunay::remove_vertices() accepts
+ * @param triangulation triangulation to choose from
+ * @return vertex indices, ascending
+ */
+inline auto independent_interior_vertices(delaunay::Delaunay &triangulation) -> std::vector<std::size_t> {
+    std::size_t const count = triangulation.get_vertices().size();
+    std::vector<char> blocked(count, 0);
+    for (auto *edge : triangulation.get_convex_hull()) {
+        blocked[edge->origin_index()] = 1;
+    }
+
+    std::vector<std::vector<std::size_t>> neighbours(count);
+    for (auto *edge : triangulation.get_primary_edges()) {
+        if (!edge->is_deleted()) {
+            neighbours[edge->origin_index()].push_back(edge->destination_index());
+            neighbours[edge->destination_index()].push_back(edge->origin_index());
+        }
+    }
+
+    std::vector<std::size_t> result;
+    for (std::size_t vertex = 0; vertex < count; vertex++) {
+        if (blocked[vertex] != 0) {
+            continue;
+        }
+        result.push_back(vertex);
+        blocked[vertex] = 1;
+        for (std::size_t neighbour : neighbours[vertex]) {
+            blocked[neighbour] = 1;
+            for (std::size_t second : neighbours[neighbour]) {
+                blocked[second] = 1;
+            }
+        }
+    }
+    return result;
+}
+
+#endif// DELAUNAY_TESTS_INDEPENDENT_VERTICES_HPP
@@ -0,0 +1,41 @@
+#ifndef DELAUNAY_TESTS_RANDOM_POINTS_HPP
+#define DELAUNAY_TESTS_RANDOM_POINTS_HPP
+
+#include "delaunay/point.hpp"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+/**
+ * Uniformly distributed points in the square [-extent, extent]², drawn from the given engine
+ * @param count number of points
+ * @param rand random engine, advanced by the draws
+ * @param extent half the side length of the square
+ * @return points
+ */
+inline auto random_points(std::size_t count, std::default_random_engine &rand, double extent = 500)
+    -> std::vector<delaunay::point_t> {
+    std::vector<delaunay::point_t> points;
+    std::uniform_real_distribution<double> distr(-extent, extent);
+
+    for (std::size_t i = 0; i < count; i++) {
+        points.emplace_back(distr(rand), distr(rand));
+    }
+    return points;
+}
+
+/**
+ * Uniformly distributed points in the square [-extent, extent]², the same for the same seed
+ * @param count number of points
+ * @param extent half the side length of the square
+ * @param seed seed of the random engine
+ * @return points
+ */
+inline auto random_points(std::size_t count, double extent = 500, unsigned seed = 0)
+    -> std::vector<delaunay::point_t> {
+    std::default_random_engine rand(seed);
+    return random_points(count, rand, extent);
+}
+
+#endif// DELAUNAY_TESTS_RANDOM_POINTS_HPP
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/allocation_statistics.hpp"
+#include "delaunay/delaunay.hpp"
+#include "random_points.hpp"
+
+#include <algorithm>
+#include <span>
+
+TEST(AllocationStatistics, TriangulationAllocatesThroughTheResource) {
+    auto const points = random_points(5000);
+    delaunay::AllocationStatistics statistics;
+    {
+        auto triangulation = delaunay::Delaunay::triangulate(std::span(points), &statistics);
+        auto reference = delaunay::Delaunay::triangulate(std::span(points));
+        ASSERT_TRUE(std::ranges::equal(triangulation.get_faces(), reference.get_faces()));
+
+        ASSERT_GT(statistics.allocation_count(), 0U);
+        ASSERT_GE(statistics.bytes_in_use(), points.size() * sizeof(delaunay::point_t));
+        ASSERT_GE(statistics.peak_bytes(), statistics.bytes_in_use());
+
+        triangulation.optimize_layout();
+        ASSERT_EQ(triangulation.get_faces().size(), reference.get_faces().size());
+    }
+
+    // Everything is returned once the triangulation is gone
+    ASSERT_EQ(statistics.bytes_in_use(), 0U);
+    ASSERT_EQ(statistics.allocation_count(), statistics.deallocation_count());
+    ASSERT_GE(statistics.total_bytes(), statistics.peak_bytes());
+}
+
+TEST(AllocationStatistics, TriangulationFitsInAMonotonicBuffer) {
+    auto const points = random_points(2000);
+
+    // Without an upstream, any allocation beyond the buffer throws
+    std::vector<std::byte> buffer(16U << 20U);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    delaunay::AllocationStatistics statistics(&arena);
+
+    auto triangulation = delaunay::Delaunay::triangulate(std::span(points), &statistics);
+    ASSERT_EQ(triangulation.get_vertices().size(), points.size());
+    ASSERT_EQ(statistics.upstream(), &arena);
+    ASSERT_LE(statistics.peak_bytes(), buffer.size());
+}
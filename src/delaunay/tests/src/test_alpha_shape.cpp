@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/alpha_shape.hpp"
+#include "delaunay/delaunay.hpp"
+#include "random_points.hpp"
+
+#include <cmath>
+#include <set>
+
+TEST(AlphaShape, InfiniteAlphaIsConvexHull) {
+    auto points = random_points(1000);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    delaunay::AlphaShape shape(triangulation);
+
+    auto boundary = shape.get_boundary(std::numeric_limits<double>::infinity());
+    auto hull = triangulation.get_convex_hull();
+
+    ASSERT_EQ(std::set<delaunay::QuadEdge *>(boundary.begin(), boundary.end()),
+              std::set<delaunay::QuadEdge *>(hull.begin(), hull.end()));
+    ASSERT_EQ(shape.get_face_count(std::numeric_limits<double>::infinity()), triangulation.get_faces().size() / 3);
+}
+
+TEST(AlphaShape, BoundaryMatchesRescan) {
+    auto points = random_points(1000);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    delaunay::AlphaShape shape(triangulation);
+    auto const &face_alphas = shape.get_face_alphas();
+
+    for (double alpha : {0.0, 10.0, 20.0, 40.0, 80.0}) {
+        auto in_complex = [&](delaunay::QuadEdge *edge) {
+            std::size_t const face = edge->left_face_index();
+            return face != delaunay::QuadEdge::INVALID_INDEX && face_alphas[face] <= alpha;
+        };
+
+        // Rescan: an edge of a triangle in the complex with the other side outside is on the boundary,
+        // or an edge with an empty diametral circle of radius <= alpha and no triangle in the complex
+        std::set<delaunay::QuadEdge *> expected;
+        for (auto *edge : triangulation.get_primary_edges()) {
+            if (edge->is_deleted()) {
+                continue;
+            }
+
+            bool const left = in_complex(edge);
+            bool const right = in_complex(edge->sym());
+            if (left != right) {
+                expected.insert(left ? edge : edge->sym());
+            } else if (!left) {
+                auto const &a = edge->origin();
+                auto const &b = edge->destination();
+                double const radius = std::hypot(a.x - b.x, a.y - b.y) / 2;
+                bool empty = radius <= alpha;
+                for (auto const &vertex : triangulation.get_vertices()) {
+                    bool const is_endpoint = vertex == a || vertex == b;
+                    empty = empty && (is_endpoint ||
+                                      std::hypot(vertex.x - (a.x + b.x) / 2, vertex.y - (a.y + b.y) / 2) >= radius);
+                }
+                if (empty) {
+                    expected.insert(edge);
+                }
+            }
+        }
+
+        auto boundary = shape.get_boundary(alpha);
+        ASSERT_EQ(std::set<delaunay::QuadEdge *>(boundary.begin(), boundary.end()), expected) << "alpha " << alpha;
+    }
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/async_triangulation.hpp"
+#include "random_points.hpp"
+
+#include <algorithm>
+#include <span>
+
+TEST(AsyncTriangulation, FutureMatchesSynchronousBuild) {
+    auto points = random_points(5000);
+    delaunay::AsyncTriangulation async;
+    ASSERT_EQ(async.latest(), nullptr);
+
+    auto result = async.submit(points).get();
+    auto reference = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+
+    ASSERT_TRUE(std::ranges::equal(result->get_vertices(), reference.get_vertices()));
+    ASSERT_TRUE(std::ranges::equal(result->get_faces(), reference.get_faces()));
+    ASSERT_EQ(async.latest(), result);
+}
+
+TEST(AsyncTriangulation, NewestSubmissionWins) {
+    delaunay::AsyncTriangulation async;
+
+    std::vector<std::future<delaunay::AsyncTriangulation::result_t>> futures;
+    for (unsigned seed = 0; seed < 8; seed++) {
+        futures.push_back(async.submit(random_points(50000, 500, seed)));
+    }
+
+    // Replaced submissions either finished before the next one arrived or were cancelled
+    for (std::size_t i = 0; i + 1 < futures.size(); i++) {
+        try {
+            ASSERT_NE(futures[i].get(), nullptr);
+        } catch (delaunay::TriangulationCancelled const &) {
+        }
+    }
+
+    auto newest = futures.back().get();
+    ASSERT_EQ(newest->get_vertices().size(), 50000U);
+    ASSERT_EQ(async.latest(), newest);
+}
+
+TEST(AsyncTriangulation, CallbackReceivesPublishedResult) {
+    delaunay::AsyncTriangulation async;
+    std::promise<delaunay::AsyncTriangulation::result_t> received;
+
+    async.submit(random_points(1000), [&received](auto const &result) { received.set_value(result); });
+
+    auto result = received.get_future().get();
+    ASSERT_EQ(result->get_vertices().size(), 1000U);
+    ASSERT_EQ(async.latest(), result);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/concurrent_insertion.hpp"
+#include "delaunay/delaunay.hpp"
+#include "random_points.hpp"
+
+#include <cmath>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+TEST(Attributes, FollowTheVertices) {
+    auto const points = random_points(5000);
+    std::vector<std::size_t> ids(points.size());
+    std::iota(ids.begin(), ids.end(), std::size_t{0});
+
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    std::ignore = triangulation.add_vertex_attribute<std::size_t>("id", ids);
+
+    auto const check = [&]() {
+        auto const values = triangulation.get_vertex_attribute<std::size_t>("id");
+        auto const &vertices = triangulation.get_vertices();
+        ASSERT_EQ(values.size(), vertices.size());
+        for (std::size_t vertex = 0; vertex < vertices.size(); vertex++) {
+            ASSERT_EQ(vertices[vertex], points[values[vertex]]);
+        }
+    };
+    check();
+
+    triangulation.optimize_layout();
+    check();
+}
+
+TEST(Attributes, ReduceDuplicates) {
+    std::vector<delaunay::point_t> points = {{0, 0}, {1, 0}, {0, 1}, {1, 0}, {1, 1}, {1, 0}};
+    std::vector<float> const weights = {1, 2, 3, 4, 5, 9};
+
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    ASSERT_EQ(triangulation.get_vertices().size(), 4U);
+    std::size_t const merged = triangulation.get_input_vertices()[1];
+
+    auto const reduced = [&](char const *name, delaunay::Reduction reduction) {
+        return triangulation.add_vertex_attribute<float>(name, weights, reduction)[merged];
+    };
+    ASSERT_EQ(reduced("first", delaunay::Reduction::FIRST), 2);
+    ASSERT_EQ(reduced("min", delaunay::Reduction::MIN), 2);
+    ASSERT_EQ(reduced("max", delaunay::Reduction::MAX), 9);
+    ASSERT_EQ(reduced("sum", delaunay::Reduction::SUM), 15);
+    ASSERT_EQ(reduced("mean", delaunay::Reduction::MEAN), 5);
+
+    // Vertices without duplicates keep their value
+    std::size_t const single = triangulation.get_input_vertices()[4];
+    ASSERT_EQ(triangulation.get_vertex_attribute<float>("sum")[single], 5);
+}
+
+TEST(Attributes, RejectInvalidChannels) {
+    auto const points = random_points(100);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+
+    std::vector<int> const labels(points.size(), 1);
+    std::ignore = triangulation.add_vertex_attribute<int>("label", labels);
+    ASSERT_THROW(std::ignore = triangulation.add_vertex_attribute<int>("label", labels), std::invalid_argument);
+    ASSERT_THROW(std::ignore = triangulation.get_vertex_attribute<float>("label"), std::invalid_argument);
+    ASSERT_THROW(std::ignore = triangulation.get_vertex_attribute<int>("missing"), std::invalid_argument);
+
+    std::vector<int> const too_few(points.size() - 1, 1);
+    ASSERT_THROW(std::ignore = triangulation.add_vertex_attribute<int>("short", too_few), std::invalid_argument);
+
+    std::vector<std::string> const names(points.size(), "a");
+    ASSERT_THROW(std::ignore = triangulation.add_vertex_attribute<std::string>("names", names, delaunay::Reduction::MIN),
+                 std::invalid_argument);
+    ASSERT_EQ(triangulation.add_vertex_attribute<std::string>("names", names).size(),
+              triangulation.get_vertices().size());
+
+    triangulation.remove_vertex_attribute("label");
+    ASSERT_THROW(std::ignore = triangulation.get_vertex_attribute<int>("label"), std::invalid_argument);
+}
+
+TEST(Attributes, FaceAreasCoverTheHull) {
+    auto const points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+
+    auto const &areas = triangulation.get_face_areas();
+    ASSERT_EQ(areas.size(), triangulation.get_faces().size() / 3);
+
+    // Shoelace formula over the hull
+    double hull_area = 0;
+    for (auto *edge : triangulation.get_convex_hull()) {
+        hull_area += edge->origin().x * edge->destination().y - edge->destination().x * edge->origin().y;
+    }
+    hull_area /= 2;
+
+    double total = 0;
+    for (double area : areas) {
+        ASSERT_GT(area, 0);
+        total += area;
+    }
+    ASSERT_NEAR(total, hull_area, hull_area * 1e-9);
+
+    // Recomputed once the faces changed
+    std::vector<delaunay::point_t> scaled(triangulation.get_vertices().begin(), triangulation.get_vertices().end());
+    for (auto &point : scaled) {
+        point = delaunay::point_t(point.x * 2, point.y * 2);
+    }
+    std::ignore = triangulation.move_vertices(scaled);
+    total = std::accumulate(triangulation.get_face_areas().begin(), triangulation.get_face_areas().end(), 0.0);
+    ASSERT_NEAR(total, 4 * hull_area, hull_area * 1e-9);
+}
+
+TEST(Attributes, SurviveRebuildsAndInserts) {
+    auto const points = random_points(1000);
+    std::vector<double> const xs = [&points]() {
+        std::vector<double> values;
+        for (auto const &point : points) {
+            values.push_back(point.x);
+        }
+        return values;
+    }();
+
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    std::ignore = triangulation.add_vertex_attribute<double>("x", xs);
+
+    // Mirroring inverts every triangle, which is only repaired by a rebuild renumbering the vertices
+    std::vector<delaunay::point_t> mirrored(triangulation.get_vertices().begin(), triangulation.get_vertices().end());
+    for (auto &point : mirrored) {
+        point = delaunay::point_t(-point.x, point.y);
+    }
+    ASSERT_FALSE(triangulation.move_vertices(mirrored));
+
+    auto const values = triangulation.get_vertex_attribute<double>("x");
+    for (std::size_t vertex = 0; vertex < values.size(); vertex++) {
+        ASSERT_EQ(values[vertex], -triangulation.get_vertices()[vertex].x);
+    }
+
+    {
+        delaunay::ConcurrentInsertion insertion(triangulation, 1);
+        ASSERT_EQ(insertion.insert({0.5, 0.5}), delaunay::ConcurrentInsertion::Result::INSERTED);
+    }
+    ASSERT_EQ(triangulation.get_vertex_attribute<double>("x").size(), triangulation.get_vertices().size());
+    ASSERT_EQ(triangulation.get_vertex_attribute<double>("x").back(), 0);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/allocation_statistics.hpp"
+#include "delaunay/batch_triangulation.hpp"
+#include "delaunay/delaunay.hpp"
+#include "random_points.hpp"
+
+#include <random>
+
+TEST(BatchTriangulation, MatchesSingleTriangulations) {
+    std::default_random_engine rand;
+    std::uniform_int_distribution<std::size_t> sizes(0, 500);
+
+    std::vector<std::vector<delaunay::point_t>> clusters;
+    for (std::size_t i = 0; i < 200; i++) {
+        clusters.push_back(random_points(sizes(rand), rand));
+    }
+    std::vector<std::span<delaunay::point_t const>> spans(clusters.begin(), clusters.end());
+
+    auto batch = delaunay::BatchTriangulation::triangulate(spans);
+    ASSERT_EQ(batch.size(), clusters.size());
+
+    for (std::size_t set = 0; set < clusters.size(); set++) {
+        auto points = clusters[set];
+        auto triangulation = delaunay::Delaunay::triangulate(points);
+
+        auto vertices = batch.get_vertices(set);
+        ASSERT_TRUE(std::equal(vertices.begin(), vertices.end(), triangulation.get_vertices().begin(),
+                               triangulation.get_vertices().end()));
+
+        auto faces = batch.get_faces(set);
+        ASSERT_TRUE(std::equal(faces.begin(), faces.end(), triangulation.get_faces().begin(),
+                               triangulation.get_faces().end()));
+
+        std::size_t live_edges = 0;
+        for (auto *edge : triangulation.get_primary_edges()) {
+            live_edges += edge->is_deleted() ? 0 : 1;
+        }
+        ASSERT_EQ(batch.get_edges(set).size(), 2 * live_edges);
+    }
+}
+
+TEST(BatchTriangulation, WorkspacesComeFromTheResourceAndAreReleased) {
+    std::default_random_engine rand;
+    std::vector<std::vector<delaunay::point_t>> clusters;
+    for (std::size_t i = 0; i < 50; i++) {
+        clusters.push_back(random_points(300, rand));
+    }
+    std::vector<std::span<delaunay::point_t const>> spans(clusters.begin(), clusters.end());
+
+    delaunay::AllocationStatistics statistics;
+    auto batch = delaunay::BatchTriangulation::triangulate(spans, &statistics);
+    ASSERT_EQ(batch.size(), clusters.size());
+
+    // The edge storage of the workers is gone with the call
+    ASSERT_GT(statistics.allocation_count(), 0U);
+    ASSERT_EQ(statistics.bytes_in_use(), 0U);
+    ASSERT_EQ(statistics.allocation_count(), statistics.deallocation_count());
+}
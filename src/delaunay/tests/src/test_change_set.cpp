@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/concurrent_insertion.hpp"
+#include "delaunay/delaunay.hpp"
+#include "independent_vertices.hpp"
+#include "random_points.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <span>
+
+namespace {
+    using edge_t = std::array<std::size_t, 2>;
+    using face_t = std::array<std::size_t, 3>;
+
+    /**
+     * Faces rotated to start at their smallest vertex, as in the change set
+     */
+    auto face_set(delaunay::Delaunay &triangulation) -> std::set<face_t> {
+        std::set<face_t> result;
+        auto const &faces = triangulation.get_faces();
+        for (std::size_t i = 0; i < faces.size(); i += 3) {
+            face_t face = {faces[i], faces[i + 1], faces[i + 2]};
+            std::rotate(face.begin(), std::min_element(face.begin(), face.end()), face.end());
+            result.insert(face);
+        }
+        return result;
+    }
+
+    /**
+     * Distance of a vertex to the lines of the opposite edges of its triangles, it can move less without inverting one
+     */
+    auto free_distance(delaunay::Delaunay &triangulation, std::size_t vertex) -> double {
+        auto const &faces = triangulation.get_faces();
+        auto const &vertices = triangulation.get_vertices();
+        double result = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < faces.size(); i += 3) {
+            for (std::size_t corner = 0; corner < 3; corner++) {
+                if (faces[i + corner] != vertex) {
+                    continue;
+                }
+                auto const &a = vertices[faces[i + (corner + 1) % 3]];
+                auto const &b = vertices[faces[i + (corner + 2) % 3]];
+                auto const &p = vertices[vertex];
+                double const cross = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+                result = std::min(result, std::abs(cross) / std::hypot(b.x - a.x, b.y - a.y));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Moves a vertex to the target in steps that invert no triangle, so it is repaired by flips only
+     */
+    void move_by_flips(delaunay::Delaunay &triangulation, std::size_t vertex, delaunay::point_t const &target) {
+        for (std::size_t i = 0; i < 100; i++) {
+            std::vector<delaunay::point_t> positions(triangulation.get_vertices().begin(),
+                                                     triangulation.get_vertices().end());
+            auto const &current = positions[vertex];
+            double const remaining = std::hypot(target.x - current.x, target.y - current.y);
+            double const step = std::min(1.0, free_distance(triangulation, vertex) * 0.9 / remaining);
+            positions[vertex] = step == 1.0 ? target
+                                            : delaunay::point_t(current.x + (target.x - current.x) * step,
+                                                                current.y + (target.y - current.y) * step);
+            ASSERT_TRUE(triangulation.move_vertices(positions));
+            if (step == 1.0) {
+                return;
+            }
+        }
+        FAIL() << "Vertex did not reach the target";
+    }
+
+    /**
+     * Applies the face changes to the faces before them
+     */
+    auto apply(std::set<face_t> faces, delaunay::ChangeSet const &changes) -> std::set<face_t> {
+        for (auto const &face : changes.deleted_faces) {
+            EXPECT_EQ(faces.erase(face), 1U);
+        }
+        for (auto const &face : changes.created_faces) {
+            EXPECT_TRUE(faces.insert(face).second);
+        }
+        return faces;
+    }
+}// namespace
+
+TEST(ChangeSet, RecordsLocalFlips) {
+    auto const points = random_points(5000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    triangulation.track_changes(true);
+    auto const before = face_set(triangulation);
+
+    // Moving one vertex a little only flips edges around it
+    std::vector<delaunay::point_t> positions(triangulation.get_vertices().begin(), triangulation.get_vertices().end());
+    std::size_t const moved = 2500;
+    double const step = free_distance(triangulation, moved) * 0.9;
+    positions[moved] = delaunay::point_t(positions[moved].x + step, positions[moved].y);
+    ASSERT_TRUE(triangulation.move_vertices(positions));
+
+    auto const &changes = triangulation.get_changes();
+    ASSERT_EQ(apply(before, changes), face_set(triangulation));
+    ASSERT_FALSE(changes.created_faces.empty());
+    ASSERT_LT(changes.created_faces.size(), 100U);
+    ASSERT_TRUE(std::binary_search(changes.dirty_vertices.begin(), changes.dirty_vertices.end(), moved));
+    ASSERT_LT(changes.dirty_vertices.size(), 100U);
+    ASSERT_TRUE(changes.renumbered_vertices.empty());
+    for (auto const &edge : changes.created_edges) {
+        ASSERT_LT(edge[0], edge[1]);
+        ASSERT_TRUE(std::binary_search(changes.dirty_vertices.begin(), changes.dirty_vertices.end(), edge[0]));
+    }
+}
+
+TEST(ChangeSet, ChurnCancelsOut) {
+    auto const points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    triangulation.track_changes(true);
+
+    std::vector<delaunay::point_t> const original(triangulation.get_vertices().begin(),
+                                                  triangulation.get_vertices().end());
+    move_by_flips(triangulation, 1000, delaunay::point_t(original[1000].x + 20, original[1000].y + 30));
+    ASSERT_FALSE(triangulation.get_changes().created_faces.empty());
+
+    // Moving back restores the triangulation, only the moved vertex stays dirty
+    move_by_flips(triangulation, 1000, original[1000]);
+    auto const &changes = triangulation.get_changes();
+    ASSERT_TRUE(changes.created_faces.empty());
+    ASSERT_TRUE(changes.deleted_faces.empty());
+    ASSERT_TRUE(changes.created_edges.empty());
+    ASSERT_TRUE(changes.deleted_edges.empty());
+    ASSERT_TRUE(std::binary_search(changes.dirty_vertices.begin(), changes.dirty_vertices.end(), 1000));
+
+    std::uint64_t const epoch = changes.epoch;
+    ASSERT_EQ(triangulation.clear_changes(), epoch + 1);
+    ASSERT_TRUE(triangulation.get_changes().dirty_vertices.empty());
+}
+
+TEST(ChangeSet, RecordsInserts) {
+    auto const points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    triangulation.track_changes(true);
+    auto const before = face_set(triangulation);
+    std::size_t const base = triangulation.get_vertices().size();
+
+    {
+        delaunay::ConcurrentInsertion insertion(triangulation, 2);
+        ASSERT_EQ(insertion.insert({1.5, 2.5}), delaunay::ConcurrentInsertion::Result::INSERTED);
+        ASSERT_EQ(insertion.insert({-100.5, 42.5}), delaunay::ConcurrentInsertion::Result::INSERTED);
+    }
+
+    auto const &changes = triangulation.get_changes();
+    ASSERT_EQ(apply(before, changes), face_set(triangulation));
+    for (auto const &face : changes.created_faces) {
+        ASSERT_TRUE(std::find_if(face.begin(), face.end(), [base](std::size_t v) { return v >= base; }) != face.end());
+    }
+}
+
+TEST(ChangeSet, RecordsRebuildsAndRenumbering) {
+    auto const points = random_points(1000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    triangulation.track_changes(true);
+
+    // Renumbering alone changes no face
+    auto const before = face_set(triangulation);
+    triangulation.optimize_layout();
+    auto const &changes = triangulation.get_changes();
+    ASSERT_TRUE(changes.created_faces.empty());
+    ASSERT_EQ(changes.renumbered_vertices.size(), triangulation.get_vertices().size());
+
+    // Mirroring the vertices forces a rebuild, the faces before are given in the new numbering
+    std::vector<delaunay::point_t> mirrored(triangulation.get_vertices().begin(), triangulation.get_vertices().end());
+    for (auto &point : mirrored) {
+        point = delaunay::point_t(-point.x, point.y);
+    }
+    ASSERT_FALSE(triangulation.move_vertices(mirrored));
+
+    std::set<face_t> renumbered;
+    for (auto face : before) {
+        for (std::size_t &vertex : face) {
+            vertex = changes.renumbered_vertices[vertex];
+        }
+        std::rotate(face.begin(), std::min_element(face.begin(), face.end()), face.end());
+        renumbered.insert(face);
+    }
+    ASSERT_EQ(apply(renumbered, changes), face_set(triangulation));
+    ASSERT_EQ(changes.dirty_vertices.size(), triangulation.get_vertices().size());
+}
+
+TEST(ChangeSet, RecordsRemovedVertices) {
+    auto const points = random_points(1000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    triangulation.track_changes(true);
+
+    // Renumbered first, so the removed edges and faces are given in the numbering before optimize_layout()
+    auto const before = face_set(triangulation);
+    triangulation.optimize_layout();
+    triangulation.remove_vertices(independent_interior_vertices(triangulation));
+    auto const &changes = triangulation.get_changes();
+    auto const is_removed = [&changes](std::size_t vertex) {
+        return changes.renumbered_vertices[vertex] == delaunay::QuadEdge::INVALID_INDEX;
+    };
+
+    std::set<face_t> renumbered;
+    std::set<face_t> removed_faces;
+    std::set<edge_t> removed_edges;
+    for (auto face : before) {
+        if (std::any_of(face.begin(), face.end(), is_removed)) {
+            removed_faces.insert(face);
+            for (std::size_t i = 0; i < 3; i++) {
+                std::size_t const a = face[i];
+                std::size_t const b = face[(i + 1) % 3];
+                if (is_removed(a) || is_removed(b)) {
+                    removed_edges.insert({std::min(a, b), std::max(a, b)});
+                }
+            }
+            continue;
+        }
+        for (std::size_t &vertex : face) {
+            vertex = changes.renumbered_vertices[vertex];
+        }
+        std::rotate(face.begin(), std::min_element(face.begin(), face.end()), face.end());
+        renumbered.insert(face);
+    }
+
+    ASSERT_FALSE(removed_faces.empty());
+    ASSERT_EQ(std::set<face_t>(changes.removed_faces.begin(), changes.removed_faces.end()), removed_faces);
+    ASSERT_EQ(std::set<edge_t>(changes.removed_edges.begin(), changes.removed_edges.end()), removed_edges);
+    ASSERT_EQ(apply(renumbered, changes), face_set(triangulation));
+
+    triangulation.clear_changes();
+    ASSERT_TRUE(triangulation.get_changes().removed_faces.empty());
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/concurrent_insertion.hpp"
+#include "random_points.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace {
+    auto distance(delaunay::point_t const &a, delaunay::point_t const &b) -> double {
+        return std::hypot(a.x - b.x, a.y - b.y);
+    }
+}// namespace
+
+TEST(ConcurrentInsertion, InsertsFromManyThreadsAndStaysDelaunay) {
+    auto const points = random_points(2000, 500, 1);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span(points));
+    std::size_t const base_count = triangulation.get_vertices().size();
+
+    constexpr std::size_t THREADS = 4;
+    constexpr std::size_t PER_THREAD = 2000;
+    std::atomic<std::size_t> inserted{0};
+    std::atomic<bool> writing{true};
+    std::atomic<bool> readers_valid{true};
+    {
+        delaunay::ConcurrentInsertion insertion(triangulation, THREADS * PER_THREAD);
+
+        // A reader keeps looking up triangles while the writers insert
+        std::thread reader([&]() {
+            auto const queries = random_points(1000, 400, 7);
+            std::vector<std::size_t> neighbours;
+            while (writing) {
+                for (auto const &query : queries) {
+                    auto const triangle = insertion.find_triangle(query);
+                    if (!triangle.has_value()) {
+                        readers_valid = false;
+                        continue;
+                    }
+                    insertion.get_neighbours((*triangle)[0], neighbours);
+                    if (std::find(neighbours.begin(), neighbours.end(), (*triangle)[1]) == neighbours.end()) {
+                        readers_valid = false;
+                    }
+                }
+            }
+        });
+
+        std::vector<std::thread> writers;
+        for (std::size_t thread = 0; thread < THREADS; thread++) {
+            writers.emplace_back([&, thread]() {
+                for (auto const &point : random_points(PER_THREAD, 550, 100 + thread)) {
+                    if (insertion.insert(point) == delaunay::ConcurrentInsertion::Result::INSERTED) {
+                        inserted++;
+                    }
+                }
+            });
+        }
+        for (auto &writer : writers) {
+            writer.join();
+        }
+        writing = false;
+        reader.join();
+
+        ASSERT_EQ(insertion.size(), inserted);
+        ASSERT_EQ(insertion.insert(points.front()), delaunay::ConcurrentInsertion::Result::DUPLICATE);
+        ASSERT_EQ(insertion.insert({1000, 1000}), delaunay::ConcurrentInsertion::Result::OUTSIDE_HULL);
+    }
+    ASSERT_TRUE(readers_valid);
+
+    // Most points are inside the hull of the original points
+    auto const &vertices = triangulation.get_vertices();
+    ASSERT_GT(inserted, THREADS * PER_THREAD / 2);
+    ASSERT_EQ(vertices.size(), base_count + inserted);
+
+    // Every vertex is part of the triangulation, which has the size of a triangulation of all vertices
+    std::size_t const hull = triangulation.get_convex_hull().size();
+    ASSERT_EQ(triangulation.get_faces().size() / 3, 2 * vertices.size() - 2 - hull);
+
+    // Locally Delaunay everywhere means Delaunay
+    auto const &circumcenters = triangulation.get_circumcenters();
+    auto const &faces = triangulation.get_faces();
+    for (auto *edge : triangulation.get_primary_edges()) {
+        if (edge->is_deleted() || !edge->is_left_face_triangle() || !edge->sym()->is_left_face_triangle()) {
+            continue;
+        }
+        std::size_t const face = edge->left_face_index();
+        auto const &opposite = edge->sym()->left_face_next()->destination();
+        double const radius = distance(circumcenters[face], vertices[faces[3 * face]]);
+        ASSERT_GE(distance(circumcenters[face], opposite), radius * (1 - 1e-6));
+    }
+
+    // Inserted points are input points after the original ones
+    auto const &origins = triangulation.get_vertex_origins();
+    auto const &input_vertices = triangulation.get_input_vertices();
+    for (std::size_t vertex = 0; vertex < vertices.size(); vertex++) {
+        ASSERT_EQ(input_vertices[origins[vertex]], vertex);
+    }
+}
+
+TEST(ConcurrentInsertion, DeletedCavityEdgesLeaveNoDualEdges) {
+    auto const points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span(points));
+    {
+        delaunay::ConcurrentInsertion insertion(triangulation, 500);
+        for (auto const &point : random_points(500, 400, 3)) {
+            ASSERT_EQ(insertion.insert(point), delaunay::ConcurrentInsertion::Result::INSERTED);
+        }
+    }
+
+    // Every live dual edge joins the circumcenters of the two faces of its live primary edge
+    auto const circumcenters = triangulation.get_circumcenters();
+    auto const primary = triangulation.get_primary_edges();
+    auto const dual = triangulation.get_dual_edges();
+    for (std::size_t i = 0; i < dual.size(); i++) {
+        if (dual[i]->is_deleted()) {
+            continue;
+        }
+        ASSERT_FALSE(primary[i]->is_deleted());
+        ASSERT_EQ(dual[i]->origin(), circumcenters[primary[i]->sym()->left_face_index()]);
+        ASSERT_EQ(dual[i]->destination(), circumcenters[primary[i]->left_face_index()]);
+    }
+}
@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/decimation.hpp"
+#include "delaunay/delaunay.hpp"
+#include "independent_vertices.hpp"
+#include "random_points.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /**
+     * Checks Euler's formula for a triangulated point set and that no vertex lies in the circumcircle of a face
+     */
+    void expect_delaunay(delaunay::Delaunay &triangulation) {
+        auto const &vertices = triangulation.get_vertices();
+        auto const &faces = triangulation.get_faces();
+        std::size_t const hull = triangulation.get_convex_hull().size();
+        ASSERT_EQ(faces.size() / 3, 2 * vertices.size() - 2 - hull);
+
+        for (std::size_t face = 0; face < faces.size(); face += 3) {
+            auto const &a = vertices[faces[face]];
+            auto const &b = vertices[faces[face + 1]];
+            auto const &c = vertices[faces[face + 2]];
+            ASSERT_TRUE(delaunay::point_t::counter_clock_wise(a, b, c));
+            for (auto const &vertex : vertices) {
+                ASSERT_FALSE(delaunay::point_t::in_circle(a, b, c, vertex));
+            }
+        }
+    }
+
+    /**
+     * Checks that the ids, vertices and circumcenters of the faces and the dual edges describe the same triangles
+     */
+    void expect_consistent_faces(delaunay::Delaunay &triangulation) {
+        auto const &vertices = triangulation.get_vertices();
+        auto const faces = triangulation.get_faces();
+        auto const face_edges = triangulation.get_face_edges();
+        auto const circumcenters = triangulation.get_circumcenters();
+        ASSERT_EQ(faces.size(), 3 * face_edges.size());
+        ASSERT_EQ(circumcenters.size(), face_edges.size());
+
+        for (std::size_t face = 0; face < face_edges.size(); face++) {
+            ASSERT_EQ(circumcenters[face], delaunay::point_t::circumcenter(vertices[faces[3 * face]],
+                                                                          vertices[faces[3 * face + 1]],
+                                                                          vertices[faces[3 * face + 2]]));
+            delaunay::QuadEdge *edge = face_edges[face];
+            for (std::size_t corner = 0; corner < 3; corner++) {
+                ASSERT_EQ(edge->left_face_index(), face);
+                ASSERT_EQ(edge->origin_index(), faces[3 * face + corner]);
+                ASSERT_EQ(edge->inv_rot()->origin(), circumcenters[face]);
+                edge = edge->left_face_next();
+            }
+        }
+
+        // No other edge has a face id
+        std::size_t numbered = 0;
+        for (auto *edge : triangulation.get_primary_edges()) {
+            for (auto *side : {edge, edge->sym()}) {
+                numbered += !edge->is_deleted() && side->left_face_index() != delaunay::QuadEdge::INVALID_INDEX ? 1 : 0;
+            }
+        }
+        ASSERT_EQ(numbered, faces.size());
+
+        // Every live dual edge joins the circumcenters of the two faces of its live primary edge
+        auto const primary = triangulation.get_primary_edges();
+        auto const dual = triangulation.get_dual_edges();
+        for (std::size_t i = 0; i < dual.size(); i++) {
+            if (dual[i]->is_deleted()) {
+                continue;
+            }
+            ASSERT_FALSE(primary[i]->is_deleted());
+            ASSERT_EQ(dual[i]->origin(), circumcenters[primary[i]->sym()->left_face_index()]);
+            ASSERT_EQ(dual[i]->destination(), circumcenters[primary[i]->left_face_index()]);
+        }
+    }
+}// namespace
+
+TEST(Decimation, RemovedVerticesLeaveADelaunayTriangulation) {
+    auto const points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+
+    std::vector<double> ids(points.size());
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        ids[i] = static_cast<double>(i);
+    }
+    triangulation.add_vertex_attribute<double>("id", ids);
+
+    auto const removed = independent_interior_vertices(triangulation);
+    ASSERT_GT(removed.size(), 100U);
+    std::size_t const before = triangulation.get_vertices().size();
+
+    ASSERT_TRUE(triangulation.remove_vertices(removed));
+    ASSERT_EQ(triangulation.get_vertices().size(), before - removed.size());
+    expect_delaunay(triangulation);
+    expect_consistent_faces(triangulation);
+
+    // Origins, inputs and attributes follow the compacted vertices
+    auto const &origins = triangulation.get_vertex_origins();
+    auto const &inputs = triangulation.get_input_vertices();
+    auto const values = triangulation.get_vertex_attribute<double>("id");
+    std::size_t dropped = 0;
+    for (std::size_t vertex = 0; vertex < origins.size(); vertex++) {
+        ASSERT_EQ(values[vertex], static_cast<double>(origins[vertex]));
+        ASSERT_EQ(inputs[origins[vertex]], vertex);
+        ASSERT_EQ(triangulation.get_vertices()[vertex], points[origins[vertex]]);
+    }
+    for (std::size_t input : inputs) {
+        dropped += input == delaunay::QuadEdge::INVALID_INDEX ? 1 : 0;
+    }
+    ASSERT_EQ(dropped, removed.size());
+}
+
+TEST(Decimation, DetachedVerticesKeepTheirIndicesUntilCompacted) {
+    auto const points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    std::vector<delaunay::point_t> const vertices(triangulation.get_vertices().begin(),
+                                                  triangulation.get_vertices().end());
+
+    auto const removed = independent_interior_vertices(triangulation);
+    std::vector<delaunay::QuadEdge *> leaving(vertices.size(), nullptr);
+    for (auto *edge : triangulation.get_primary_edges()) {
+        if (!edge->is_deleted()) {
+            leaving[edge->origin_index()] = edge;
+            leaving[edge->destination_index()] = edge->sym();
+        }
+    }
+    std::vector<delaunay::QuadEdge *> removed_edges;
+    for (std::size_t vertex : removed) {
+        removed_edges.push_back(leaving[vertex]);
+    }
+    ASSERT_TRUE(triangulation.detach_vertices(removed_edges));
+
+    // Nothing is renumbered, the faces only use the remaining vertices
+    ASSERT_TRUE(std::ranges::equal(triangulation.get_vertices(), vertices));
+    ASSERT_TRUE(std::ranges::equal(triangulation.get_detached_vertices(), removed));
+    ASSERT_EQ(triangulation.get_faces().size() / 3,
+              2 * (vertices.size() - removed.size()) - 2 - triangulation.get_convex_hull().size());
+    for (std::size_t vertex : triangulation.get_faces()) {
+        ASSERT_EQ(std::find(removed.begin(), removed.end(), vertex), removed.end());
+    }
+    expect_consistent_faces(triangulation);
+
+    triangulation.compact_vertices();
+    ASSERT_TRUE(triangulation.get_detached_vertices().empty());
+    ASSERT_EQ(triangulation.get_vertices().size(), vertices.size() - removed.size());
+    expect_delaunay(triangulation);
+    expect_consistent_faces(triangulation);
+}
+
+TEST(Decimation, RejectsHullAndDependentVertices) {
+    auto const points = random_points(500);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    std::size_t const count = triangulation.get_vertices().size();
+
+    std::vector<std::size_t> hull = {triangulation.get_convex_hull().front()->origin_index()};
+    ASSERT_THROW(triangulation.remove_vertices(hull), std::invalid_argument);
+
+    auto const interior = independent_interior_vertices(triangulation);
+    delaunay::QuadEdge *edge = nullptr;
+    for (auto *primary : triangulation.get_primary_edges()) {
+        if (!primary->is_deleted() && primary->origin_index() == interior.front()) {
+            edge = primary;
+        }
+        if (!primary->is_deleted() && primary->destination_index() == interior.front()) {
+            edge = primary->sym();
+        }
+    }
+    ASSERT_NE(edge, nullptr);
+    std::vector<std::size_t> neighbours = {interior.front(), edge->destination_index()};
+    ASSERT_THROW(triangulation.remove_vertices(neighbours), std::invalid_argument);
+
+    std::vector<std::size_t> duplicates = {interior.front(), interior.front()};
+    ASSERT_THROW(triangulation.remove_vertices(duplicates), std::invalid_argument);
+    ASSERT_EQ(triangulation.get_vertices().size(), count);
+}
+
+TEST(Decimation, PlanarHeightFieldDecimatesWithoutError) {
+    auto const points = random_points(3000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+
+    std::vector<double> heights;
+    for (auto const &point : points) {
+        heights.push_back(0.5 * point.x - 0.25 * point.y + 10);
+    }
+    auto const initial_heights = triangulation.add_vertex_attribute<double>("height", heights);
+    std::vector<double> const vertex_heights(initial_heights.begin(), initial_heights.end());
+    std::vector<delaunay::point_t> const vertices(triangulation.get_vertices().begin(),
+                                                  triangulation.get_vertices().end());
+
+    delaunay::Decimation decimation(triangulation, "height");
+    std::vector<std::size_t> const counts = {2000, 1000, 200};
+    auto const levels = decimation.progressive(counts, 1e-6);
+    ASSERT_EQ(levels.size(), counts.size());
+
+    for (std::size_t level = 0; level < levels.size(); level++) {
+        ASSERT_EQ(levels[level].vertices.size(), counts[level]);
+        ASSERT_LE(levels[level].max_error, 1e-6);
+        for (std::size_t vertex = 0; vertex < levels[level].vertices.size(); vertex++) {
+            ASSERT_EQ(levels[level].vertices[vertex], vertices[levels[level].origins[vertex]]);
+            ASSERT_EQ(levels[level].heights[vertex], vertex_heights[levels[level].origins[vertex]]);
+        }
+    }
+    expect_delaunay(triangulation);
+}
+
+TEST(Decimation, ErrorBoundStopsDecimation) {
+    auto const points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+
+    std::vector<double> heights;
+    for (auto const &point : points) {
+        heights.push_back(std::sin(point.x / 50) * std::cos(point.y / 50) * 20);
+    }
+    triangulation.add_vertex_attribute<double>("height", heights);
+
+    delaunay::Decimation decimation(triangulation, "height");
+    std::size_t const left = decimation.decimate(0, 0.5);
+    ASSERT_GT(left, triangulation.get_convex_hull().size());
+    ASSERT_LT(left, 2000U);
+    ASSERT_GT(decimation.get_max_error(), 0);
+    ASSERT_LE(decimation.get_max_error(), 0.5);
+    ASSERT_EQ(decimation.step(0, 0.5), 0U);
+    expect_delaunay(triangulation);
+    expect_consistent_faces(triangulation);
+
+    // Without a bound only the hull is left
+    std::size_t const hull = triangulation.get_convex_hull().size();
+    ASSERT_EQ(decimation.decimate(0, std::numeric_limits<double>::infinity()), hull);
+    ASSERT_EQ(decimation.step(0, std::numeric_limits<double>::infinity()), 0U);
+    ASSERT_TRUE(std::isfinite(decimation.get_max_error()));
+
+    ASSERT_THROW(delaunay::Decimation(triangulation, "missing"), std::invalid_argument);
+}
+
+TEST(Decimation, AttributesAddedAfterRemovalSkipRemovedPoints) {
+    // Every point twice, so the reductions combine the values of duplicates
+    auto points = random_points(1000);
+    std::size_t const unique = points.size();
+    points.insert(points.end(), points.begin(), points.begin() + static_cast<std::ptrdiff_t>(unique));
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+
+    std::vector<double> heights;
+    std::vector<double> values;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        heights.push_back(std::sin(points[i].x / 50) * 20);
+        values.push_back(static_cast<double>(i));
+    }
+    triangulation.add_vertex_attribute<double>("height", heights);
+
+    triangulation.remove_vertices(independent_interior_vertices(triangulation));
+    delaunay::Decimation decimation(triangulation, "height");
+    ASSERT_GT(decimation.step(0, 1), 0U);
+    decimation.compact();
+
+    std::vector<std::pair<std::string, delaunay::Reduction>> const reductions = {
+        {"min", delaunay::Reduction::MIN},
+        {"max", delaunay::Reduction::MAX},
+        {"sum", delaunay::Reduction::SUM},
+        {"mean", delaunay::Reduction::MEAN}};
+    for (auto const &[name, reduction] : reductions) {
+        triangulation.add_vertex_attribute<double>(name, values, reduction);
+    }
+
+    auto const &inputs = triangulation.get_input_vertices();
+    for (std::size_t input = 0; input < unique; input++) {
+        ASSERT_EQ(inputs[input], inputs[input + unique]);
+        if (inputs[input] == delaunay::QuadEdge::INVALID_INDEX) {
+            continue;
+        }
+        auto const first = static_cast<double>(input);
+        auto const second = static_cast<double>(input + unique);
+        ASSERT_EQ(triangulation.get_vertex_attribute<double>("min")[inputs[input]], first);
+        ASSERT_EQ(triangulation.get_vertex_attribute<double>("max")[inputs[input]], second);
+        ASSERT_EQ(triangulation.get_vertex_attribute<double>("sum")[inputs[input]], first + second);
+        ASSERT_EQ(triangulation.get_vertex_attribute<double>("mean")[inputs[input]], (first + second) / 2);
+    }
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/delaunay.hpp"
+#include "random_points.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    auto distance(delaunay::point_t const &a, delaunay::point_t const &b) -> double {
+        return std::hypot(a.x - b.x, a.y - b.y);
+    }
+}// namespace
+
+/*****************
+ * Vornoi Graph *
+ *****************/
+TEST(Delaunay, EveryTriangleHasAFaceId) {
+    auto points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+
+    std::size_t live_edges = 0;
+    for (auto *edge : triangulation.get_primary_edges()) {
+        if (edge->is_deleted()) {
+            continue;
+        }
+        live_edges++;
+
+        for (auto *side : {edge, edge->sym()}) {
+            ASSERT_EQ(side->is_left_face_triangle(), side->left_face_index() != delaunay::QuadEdge::INVALID_INDEX);
+        }
+    }
+
+    // Euler: E = V + F - 1 (without the outer face)
+    std::size_t const face_count = triangulation.get_faces().size() / 3;
+    ASSERT_EQ(live_edges, triangulation.get_vertices().size() + face_count - 1);
+    ASSERT_EQ(triangulation.get_face_edges().size(), face_count);
+    ASSERT_EQ(triangulation.get_circumcenters().size(), face_count);
+}
+
+TEST(Delaunay, DualEdgesStartAtCircumcenters) {
+    auto points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto const &vertices = triangulation.get_vertices();
+    auto const &faces = triangulation.get_faces();
+    auto const &circumcenters = triangulation.get_circumcenters();
+
+    for (std::size_t face = 0; face < circumcenters.size(); face++) {
+        double const radius = distance(circumcenters[face], vertices[faces[3 * face]]);
+        ASSERT_NEAR(distance(circumcenters[face], vertices[faces[3 * face + 1]]), radius, 1e-6 * radius);
+        ASSERT_NEAR(distance(circumcenters[face], vertices[faces[3 * face + 2]]), radius, 1e-6 * radius);
+
+        auto *edge = triangulation.get_face_edges()[face];
+        ASSERT_EQ(edge->left_face_index(), face);
+        ASSERT_EQ(edge->inv_rot()->origin(), circumcenters[face]);
+    }
+}
+
+/***************
+ * Convex Hull *
+ ***************/
+TEST(Delaunay, ConvexHullIsClosedAndConvex) {
+    auto points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto hull = triangulation.get_convex_hull();
+
+    ASSERT_GE(hull.size(), 3U);
+    for (std::size_t i = 0; i < hull.size(); i++) {
+        auto *edge = hull[i];
+        ASSERT_EQ(edge->destination_index(), hull[(i + 1) % hull.size()]->origin_index());
+        ASSERT_TRUE(edge->is_left_face_triangle());
+        ASSERT_FALSE(edge->sym()->is_left_face_triangle());
+
+        for (auto const &vertex : triangulation.get_vertices()) {
+            ASSERT_FALSE(edge->is_point_on_right(vertex));
+        }
+    }
+}
+
+/*****************
+ * Caller Memory *
+ *****************/
+TEST(Delaunay, SpanTriangulationKeepsCallerPoints) {
+    auto points = random_points(2000);
+    // Duplicate some points, they are merged into the vertex of their first occurrence
+    for (std::size_t i = 0; i < 100; i++) {
+        points.push_back(points[i * 7]);
+    }
+    std::vector<delaunay::point_t> const input = points;
+
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    ASSERT_EQ(points, input);
+
+    auto const &vertices = triangulation.get_vertices();
+    auto const &origins = triangulation.get_vertex_origins();
+    auto const &input_vertices = triangulation.get_input_vertices();
+    ASSERT_EQ(origins.size(), vertices.size());
+    ASSERT_EQ(input_vertices.size(), input.size());
+
+    for (std::size_t vertex = 0; vertex < vertices.size(); vertex++) {
+        ASSERT_EQ(vertices[vertex], input[origins[vertex]]);
+        ASSERT_EQ(input_vertices[origins[vertex]], vertex);
+    }
+    for (std::size_t i = 0; i < input.size(); i++) {
+        ASSERT_EQ(vertices[input_vertices[i]], input[i]);
+    }
+    for (std::size_t i = 0; i < 100; i++) {
+        ASSERT_EQ(origins[input_vertices[2000 + i]], i * 7);
+    }
+
+    // Same triangulation as the mutating overload
+    auto sorted = input;
+    auto reference = delaunay::Delaunay::triangulate(sorted);
+    ASSERT_TRUE(std::ranges::equal(vertices, sorted));
+    ASSERT_TRUE(std::ranges::equal(triangulation.get_faces(), reference.get_faces()));
+}
+
+/*****************
+ * Divide and Conquer *
+ *****************/
+
+TEST(Delaunay, EveryLeafLayoutMergesIntoOneTriangulation) {
+    // Covers one triangle, one edge and two edges left over from the leaf sweep, and odd hulls moving up a level
+    for (std::size_t count = 3; count < 80; count++) {
+        auto points = random_points(count);
+        auto triangulation = delaunay::Delaunay::triangulate(points);
+        auto const &vertices = triangulation.get_vertices();
+        auto const &faces = triangulation.get_faces();
+
+        // Euler: a triangulation of n points with h hull points has 2n - h - 2 triangles
+        std::size_t const hull = triangulation.get_convex_hull().size();
+        ASSERT_EQ(faces.size() / 3, 2 * vertices.size() - hull - 2) << count;
+
+        // No vertex lies inside the circumcircle of a triangle
+        auto const &circumcenters = triangulation.get_circumcenters();
+        for (std::size_t face = 0; face < faces.size() / 3; face++) {
+            double const radius = distance(circumcenters[face], vertices[faces[3 * face]]);
+            for (auto const &vertex : vertices) {
+                ASSERT_GE(distance(circumcenters[face], vertex), radius * (1 - 1e-6)) << count;
+            }
+        }
+    }
+}
+
+TEST(Delaunay, TilesMergeIntoOneTriangulation) {
+    // More leaves than fit into one merge tile, with a partial tile at the end
+    for (std::size_t count : {6144, 6145, 20000}) {
+        auto points = random_points(count);
+        auto triangulation = delaunay::Delaunay::triangulate(points);
+        std::size_t const hull = triangulation.get_convex_hull().size();
+        ASSERT_EQ(triangulation.get_faces().size() / 3, 2 * triangulation.get_vertices().size() - hull - 2) << count;
+    }
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/delaunay.hpp"
+#include "random_points.hpp"
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+namespace {
+    using segment_t = std::array<double, 4>;
+
+    /**
+     * Live edges by coordinates, independent of the numbering
+     */
+    auto edge_segments(delaunay::Delaunay &triangulation) -> std::vector<segment_t> {
+        std::vector<segment_t> segments;
+        for (auto *edge : triangulation.get_primary_edges()) {
+            if (edge->is_deleted()) {
+                continue;
+            }
+            auto a = edge->origin();
+            auto b = edge->destination();
+            if (std::pair(a.x, a.y) > std::pair(b.x, b.y)) {
+                std::swap(a, b);
+            }
+            segments.push_back({a.x, a.y, b.x, b.y});
+        }
+        std::sort(segments.begin(), segments.end());
+        return segments;
+    }
+
+    /**
+     * Median index distance between the endpoints of the live edges
+     */
+    auto median_index_gap(delaunay::Delaunay &triangulation) -> std::size_t {
+        std::vector<std::size_t> gaps;
+        for (auto *edge : triangulation.get_primary_edges()) {
+            if (!edge->is_deleted()) {
+                std::size_t const a = edge->origin_index();
+                std::size_t const b = edge->destination_index();
+                gaps.push_back(a > b ? a - b : b - a);
+            }
+        }
+        std::nth_element(gaps.begin(), gaps.begin() + static_cast<std::ptrdiff_t>(gaps.size() / 2), gaps.end());
+        return gaps[gaps.size() / 2];
+    }
+}// namespace
+
+TEST(Layout, KeepsTheTriangulation) {
+    auto points = random_points(20000);
+    auto reference = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+    std::size_t const gap_before = median_index_gap(triangulation);
+    triangulation.optimize_layout();
+
+    ASSERT_EQ(edge_segments(triangulation), edge_segments(reference));
+    ASSERT_EQ(triangulation.get_faces().size(), reference.get_faces().size());
+    ASSERT_EQ(triangulation.get_convex_hull().size(), reference.get_convex_hull().size());
+    ASSERT_LT(median_index_gap(triangulation), gap_before);
+
+    auto const &vertices = triangulation.get_vertices();
+    auto const &edges = triangulation.get_primary_edges();
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        auto *edge = edges[i];
+        ASSERT_FALSE(edge->is_deleted());
+        ASSERT_EQ(edge->id(), 4 * i);
+        ASSERT_EQ(edge->sym()->sym(), edge);
+        ASSERT_EQ(edge->orbit_next()->orbit_prev(), edge);
+        ASSERT_EQ(edge->origin(), vertices[edge->origin_index()]);
+        ASSERT_EQ(edge->destination(), vertices[edge->destination_index()]);
+
+        for (auto *side : {edge, edge->sym()}) {
+            if (side->is_left_face_triangle()) {
+                std::size_t const face = side->left_face_index();
+                ASSERT_EQ(side->inv_rot()->origin(), triangulation.get_circumcenters()[face]);
+            }
+        }
+    }
+
+    // The input mapping follows the renumbering
+    auto const &origins = triangulation.get_vertex_origins();
+    auto const &input_vertices = triangulation.get_input_vertices();
+    for (std::size_t vertex = 0; vertex < vertices.size(); vertex++) {
+        ASSERT_EQ(vertices[vertex], points[origins[vertex]]);
+        ASSERT_EQ(input_vertices[origins[vertex]], vertex);
+    }
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/lloyd_relaxation.hpp"
+#include "random_points.hpp"
+
+#include <cmath>
+#include <span>
+#include <vector>
+
+namespace {
+    auto distance(delaunay::point_t const &a, delaunay::point_t const &b) -> double {
+        return std::hypot(a.x - b.x, a.y - b.y);
+    }
+
+    auto closest_pair(delaunay::Delaunay &triangulation) -> double {
+        double closest = std::numeric_limits<double>::infinity();
+        for (auto *edge : triangulation.get_primary_edges()) {
+            if (!edge->is_deleted()) {
+                closest = std::min(closest, distance(edge->origin(), edge->destination()));
+            }
+        }
+        return closest;
+    }
+}// namespace
+
+TEST(LloydRelaxation, SpreadsThePointsAndStaysDelaunay) {
+    auto const points = random_points(2000);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span(points));
+    double const closest_before = closest_pair(triangulation);
+
+    delaunay::LloydRelaxation relaxation(triangulation);
+    ASSERT_EQ(relaxation.relax(20, 0), 20U);
+    ASSERT_GT(closest_pair(triangulation), 4 * closest_before);
+
+    // Every iteration was repaired by flips, none rebuilt the triangulation
+    ASSERT_EQ(relaxation.get_rebuild_count(), 0U);
+
+    auto const &vertices = triangulation.get_vertices();
+    auto const &faces = triangulation.get_faces();
+    auto const &circumcenters = triangulation.get_circumcenters();
+    ASSERT_EQ(vertices.size(), points.size());
+
+    // Empty circumcircles, checked against all vertices
+    for (std::size_t face = 0; face < circumcenters.size(); face++) {
+        double const radius = distance(circumcenters[face], vertices[faces[3 * face]]);
+        for (auto const &vertex : vertices) {
+            ASSERT_GE(distance(circumcenters[face], vertex), radius * (1 - 1e-6));
+        }
+    }
+
+    for (auto const &vertex : vertices) {
+        ASSERT_GE(vertex.x, -500);
+        ASSERT_LE(vertex.x, 500);
+        ASSERT_GE(vertex.y, -500);
+        ASSERT_LE(vertex.y, 500);
+    }
+
+    // The vertices are still traced back to their input
+    auto const &origins = triangulation.get_vertex_origins();
+    auto const &input_vertices = triangulation.get_input_vertices();
+    for (std::size_t vertex = 0; vertex < vertices.size(); vertex++) {
+        ASSERT_EQ(input_vertices[origins[vertex]], vertex);
+    }
+}
+
+TEST(LloydRelaxation, StopsOnceConverged) {
+    auto const points = random_points(200);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span(points));
+
+    delaunay::LloydRelaxation relaxation(triangulation, {-500, -500}, {500, 500});
+    std::size_t const iterations = relaxation.relax(1000, 0.1);
+    ASSERT_LT(iterations, 1000U);
+    ASSERT_LT(relaxation.step(), 0.1);
+}
+
+TEST(LloydRelaxation, ReleasedHullFacesLeaveNoDualEdges) {
+    std::vector<delaunay::point_t> const points = {{0, 0}, {10, 0}, {10, 10}, {0, 10},
+                                                   {5, 1}, {5, 5},  {3, 7},   {7, 6}};
+    auto triangulation = delaunay::Delaunay::triangulate(std::span(points));
+
+    // Moving (5, 1) across the bottom of the square releases the hull triangle below it
+    std::vector<delaunay::point_t> positions(triangulation.get_vertices().begin(),
+                                             triangulation.get_vertices().end());
+    positions[triangulation.get_input_vertices()[4]] = {5, -1};
+    ASSERT_TRUE(triangulation.move_vertices(positions));
+
+    // Every live dual edge joins the circumcenters of the two faces of its live primary edge
+    auto const circumcenters = triangulation.get_circumcenters();
+    auto const primary = triangulation.get_primary_edges();
+    auto const dual = triangulation.get_dual_edges();
+    for (std::size_t i = 0; i < dual.size(); i++) {
+        if (dual[i]->is_deleted()) {
+            continue;
+        }
+        ASSERT_FALSE(primary[i]->is_deleted());
+        ASSERT_EQ(dual[i]->origin(), circumcenters[primary[i]->sym()->left_face_index()]);
+        ASSERT_EQ(dual[i]->destination(), circumcenters[primary[i]->left_face_index()]);
+    }
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/path_search.hpp"
+#include "random_points.hpp"
+
+namespace {
+    /**
+     * Returns the first and the last live edge whose left face is a triangle
+     */
+    auto pick_start_and_goal(delaunay::Delaunay &triangulation)
+        -> std::pair<delaunay::QuadEdge *, delaunay::QuadEdge *> {
+        delaunay::QuadEdge *start = nullptr;
+        delaunay::QuadEdge *goal = nullptr;
+        for (auto *edge : triangulation.get_primary_edges()) {
+            if (!edge->is_deleted() && edge->is_left_face_triangle()) {
+                start = start == nullptr ? edge : start;
+                goal = edge;
+            }
+        }
+        return {start, goal};
+    }
+}// namespace
+
+/***************
+ * Face Search *
+ ***************/
+TEST(PathSearch, AStarMatchesDijkstra) {
+    auto points = random_points(1000);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto [start, goal] = pick_start_and_goal(triangulation);
+
+    delaunay::PathSearch search(triangulation);
+    for (auto graph : {delaunay::PathSearch::Graph::FACES, delaunay::PathSearch::Graph::EDGE_MIDPOINTS}) {
+        ASSERT_TRUE(search.find_path(start, goal, graph, nullptr, false));
+        double const dijkstra_cost = search.get_cost();
+        std::size_t const dijkstra_expanded = search.get_expanded_nodes();
+
+        ASSERT_TRUE(search.find_path(start, goal, graph));
+        ASSERT_NEAR(search.get_cost(), dijkstra_cost, 1e-9);
+        ASSERT_LE(search.get_expanded_nodes(), dijkstra_expanded);
+    }
+}
+
+TEST(PathSearch, FacePathCrossesSharedEdges) {
+    auto points = random_points(1000);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto [start, goal] = pick_start_and_goal(triangulation);
+
+    delaunay::PathSearch search(triangulation);
+    ASSERT_TRUE(search.find_path(start, goal, delaunay::PathSearch::Graph::FACES));
+
+    auto const &path = search.get_path();
+    ASSERT_GE(path.size(), 2U);
+    for (std::size_t i = 1; i < path.size(); i++) {
+        // The crossed edge must be an edge of the previous face
+        auto *previous = path[i - 1];
+        auto *crossed = path[i]->sym();
+        ASSERT_TRUE(crossed == previous || crossed == previous->left_face_next() ||
+                    crossed == previous->left_face_prev());
+    }
+}
+
+TEST(PathSearch, BlockedEdgesAreAvoided) {
+    auto points = random_points(1000);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto [start, goal] = pick_start_and_goal(triangulation);
+
+    delaunay::PathSearch search(triangulation);
+    ASSERT_TRUE(search.find_path(start, goal, delaunay::PathSearch::Graph::FACES));
+    auto *blocked = search.get_path()[1];
+    double const unblocked_cost = search.get_cost();
+
+    auto cost = [blocked](delaunay::QuadEdge *edge) -> double {
+        bool const is_blocked = edge->id() / 4 == blocked->id() / 4;
+        return is_blocked ? std::numeric_limits<double>::infinity() : 0.0;
+    };
+    ASSERT_TRUE(search.find_path(start, goal, delaunay::PathSearch::Graph::FACES, cost));
+    ASSERT_GE(search.get_cost(), unblocked_cost);
+    for (auto *edge : search.get_path()) {
+        ASSERT_NE(edge->id() / 4, blocked->id() / 4);
+    }
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/proximity_graphs.hpp"
+#include "random_points.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <utility>
+
+namespace {
+    auto distance_squared(delaunay::point_t const &a, delaunay::point_t const &b) -> double {
+        return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+    }
+
+    auto as_index_pairs(std::vector<delaunay::QuadEdge *> const &edges) -> std::set<std::pair<std::size_t, std::size_t>> {
+        std::set<std::pair<std::size_t, std::size_t>> result;
+        for (auto *edge : edges) {
+            result.emplace(std::minmax(edge->origin_index(), edge->destination_index()));
+        }
+        return result;
+    }
+}// namespace
+
+/*********************************
+ * Euclidean Minimum Spanning Tree *
+ *********************************/
+TEST(ProximityGraphs, MinimumSpanningTreeSpansAllVertices) {
+    auto points = random_points(500);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto tree = delaunay::ProximityGraphs::euclidean_minimum_spanning_tree(triangulation);
+
+    ASSERT_EQ(tree.size(), triangulation.get_vertices().size() - 1);
+    ASSERT_TRUE(std::is_sorted(tree.begin(), tree.end(), [](auto *a, auto *b) {
+        return delaunay::ProximityGraphs::squared_length(a) < delaunay::ProximityGraphs::squared_length(b);
+    }));
+}
+
+TEST(ProximityGraphs, MinimumSpanningTreeMatchesPrim) {
+    auto points = random_points(300);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto const &vertices = triangulation.get_vertices();
+
+    // O(n²) Prim on the complete graph
+    std::vector<double> best(vertices.size(), std::numeric_limits<double>::infinity());
+    std::vector<bool> done(vertices.size(), false);
+    best[0] = 0;
+    double expected = 0;
+    for (std::size_t round = 0; round < vertices.size(); round++) {
+        std::size_t next = 0;
+        double next_cost = std::numeric_limits<double>::infinity();
+        for (std::size_t i = 0; i < vertices.size(); i++) {
+            if (!done[i] && best[i] < next_cost) {
+                next = i;
+                next_cost = best[i];
+            }
+        }
+        done[next] = true;
+        expected += std::sqrt(next_cost);
+        for (std::size_t i = 0; i < vertices.size(); i++) {
+            best[i] = std::min(best[i], distance_squared(vertices[next], vertices[i]));
+        }
+    }
+
+    double actual = 0;
+    for (auto *edge : delaunay::ProximityGraphs::euclidean_minimum_spanning_tree(triangulation)) {
+        actual += std::sqrt(delaunay::ProximityGraphs::squared_length(edge));
+    }
+
+    ASSERT_NEAR(actual, expected, 1e-6);
+}
+
+/******************************
+ * Gabriel / Relative Neighbour *
+ ******************************/
+TEST(ProximityGraphs, GabrielGraphMatchesBruteForce) {
+    auto points = random_points(300);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto const &vertices = triangulation.get_vertices();
+
+    std::set<std::pair<std::size_t, std::size_t>> expected;
+    for (std::size_t a = 0; a < vertices.size(); a++) {
+        for (std::size_t b = a + 1; b < vertices.size(); b++) {
+            bool empty = true;
+            for (std::size_t c = 0; c < vertices.size() && empty; c++) {
+                empty = c == a || c == b ||
+                        (vertices[a].x - vertices[c].x) * (vertices[b].x - vertices[c].x) +
+                                (vertices[a].y - vertices[c].y) * (vertices[b].y - vertices[c].y) >= 0;
+            }
+            if (empty) {
+                expected.emplace(a, b);
+            }
+        }
+    }
+
+    ASSERT_EQ(as_index_pairs(delaunay::ProximityGraphs::gabriel_graph(triangulation)), expected);
+}
+
+TEST(ProximityGraphs, RelativeNeighbourhoodGraphMatchesBruteForce) {
+    auto points = random_points(300);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto const &vertices = triangulation.get_vertices();
+
+    std::set<std::pair<std::size_t, std::size_t>> expected;
+    for (std::size_t a = 0; a < vertices.size(); a++) {
+        for (std::size_t b = a + 1; b < vertices.size(); b++) {
+            double const length = distance_squared(vertices[a], vertices[b]);
+            bool empty = true;
+            for (std::size_t c = 0; c < vertices.size() && empty; c++) {
+                empty = c == a || c == b || distance_squared(vertices[a], vertices[c]) >= length ||
+                        distance_squared(vertices[b], vertices[c]) >= length;
+            }
+            if (empty) {
+                expected.emplace(a, b);
+            }
+        }
+    }
+
+    ASSERT_EQ(as_index_pairs(delaunay::ProximityGraphs::relative_neighbourhood_graph(triangulation)), expected);
+}
+
+TEST(ProximityGraphs, LargeInputsMatchSequentialReference) {
+    // Above MIN_PARALLEL_SIZE, so the sort and the filters run in parallel
+    auto points = random_points(40000);
+    auto triangulation = delaunay::Delaunay::triangulate(points);
+    auto const &vertices = triangulation.get_vertices();
+
+    std::vector<std::pair<std::size_t, std::size_t>> edges;
+    for (auto *edge : triangulation.get_primary_edges()) {
+        if (!edge->is_deleted()) {
+            edges.emplace_back(std::minmax(edge->origin_index(), edge->destination_index()));
+        }
+    }
+
+    // Sequential Kruskal over the Delaunay edges
+    std::sort(edges.begin(), edges.end(), [&vertices](auto const &a, auto const &b) {
+        return distance_squared(vertices[a.first], vertices[a.second]) <
+               distance_squared(vertices[b.first], vertices[b.second]);
+    });
+    std::vector<std::size_t> parent(vertices.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](std::size_t vertex) {
+        while (parent[vertex] != vertex) {
+            vertex = parent[vertex] = parent[parent[vertex]];
+        }
+        return vertex;
+    };
+    double expected = 0;
+    for (auto const &[a, b] : edges) {
+        if (find(a) != find(b)) {
+            parent[find(a)] = find(b);
+            expected += std::sqrt(distance_squared(vertices[a], vertices[b]));
+        }
+    }
+
+    auto const tree = delaunay::ProximityGraphs::euclidean_minimum_spanning_tree(triangulation);
+    ASSERT_EQ(tree.size(), vertices.size() - 1);
+    double actual = 0;
+    for (auto *edge : tree) {
+        actual += std::sqrt(delaunay::ProximityGraphs::squared_length(edge));
+    }
+    ASSERT_NEAR(actual, expected, 1e-6 * expected);
+
+    // EMST ⊆ RNG ⊆ gabriel graph, sampled edges checked against all vertices
+    auto const gabriel = as_index_pairs(delaunay::ProximityGraphs::gabriel_graph(triangulation));
+    auto const relative = as_index_pairs(delaunay::ProximityGraphs::relative_neighbourhood_graph(triangulation));
+    auto const spanning = as_index_pairs(tree);
+    ASSERT_TRUE(std::includes(relative.begin(), relative.end(), spanning.begin(), spanning.end()));
+    ASSERT_TRUE(std::includes(gabriel.begin(), gabriel.end(), relative.begin(), relative.end()));
+
+    for (std::size_t i = 0; i < edges.size(); i += 500) {
+        auto const [a, b] = edges[i];
+        double const length = distance_squared(vertices[a], vertices[b]);
+        bool in_gabriel = true;
+        bool in_relative = true;
+        for (std::size_t c = 0; c < vertices.size(); c++) {
+            if (c == a || c == b) {
+                continue;
+            }
+            in_gabriel = in_gabriel && (vertices[a].x - vertices[c].x) * (vertices[b].x - vertices[c].x) +
+                                                   (vertices[a].y - vertices[c].y) * (vertices[b].y - vertices[c].y) >=
+                                               0;
+            in_relative = in_relative && (distance_squared(vertices[a], vertices[c]) >= length ||
+                                          distance_squared(vertices[b], vertices[c]) >= length);
+        }
+        ASSERT_EQ(gabriel.count({a, b}), in_gabriel ? 1U : 0U);
+        ASSERT_EQ(relative.count({a, b}), in_relative ? 1U : 0U);
+    }
+}
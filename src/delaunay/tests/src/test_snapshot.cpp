@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/delaunay.hpp"
+#include "random_points.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace {
+    auto snapshot_path(std::string const &name) -> std::filesystem::path {
+        return std::filesystem::temp_directory_path() / name;
+    }
+}// namespace
+
+TEST(Snapshot, RoundTripKeepsConnectivity) {
+    auto points = random_points(5000);
+    auto original = delaunay::Delaunay::triangulate(points);
+    auto path = snapshot_path("delaunay_round_trip.snapshot");
+    original.save(path);
+
+    auto loaded = delaunay::Delaunay::load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_TRUE(std::ranges::equal(loaded.get_vertices(), original.get_vertices()));
+    ASSERT_TRUE(std::ranges::equal(loaded.get_faces(), original.get_faces()));
+    ASSERT_TRUE(std::ranges::equal(loaded.get_circumcenters(), original.get_circumcenters()));
+    ASSERT_EQ(loaded.get_primary_edges().size(), original.get_primary_edges().size());
+
+    for (std::size_t i = 0; i < original.get_primary_edges().size(); i++) {
+        auto *expected = original.get_primary_edges()[i];
+        auto *actual = loaded.get_primary_edges()[i];
+        ASSERT_EQ(actual->is_deleted(), expected->is_deleted());
+        if (expected->is_deleted()) {
+            continue;
+        }
+
+        ASSERT_EQ(actual->origin(), expected->origin());
+        ASSERT_EQ(actual->destination(), expected->destination());
+        ASSERT_EQ(actual->orbit_next()->id(), expected->orbit_next()->id());
+        ASSERT_EQ(actual->left_face_next()->id(), expected->left_face_next()->id());
+        ASSERT_EQ(actual->inv_rot()->origin(), expected->inv_rot()->origin());
+        ASSERT_EQ(actual->left_face_index(), expected->left_face_index());
+    }
+
+    ASSERT_EQ(loaded.get_convex_hull().size(), original.get_convex_hull().size());
+}
+
+TEST(Snapshot, RejectsOtherFiles) {
+    auto path = snapshot_path("delaunay_not_a_snapshot.snapshot");
+    {
+        std::ofstream file(path);
+        file << "not a snapshot";
+    }
+
+    ASSERT_THROW(std::ignore = delaunay::Delaunay::load(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(Snapshot, RejectsCorruptHeadersAndIds) {
+    auto points = random_points(500);
+    auto original = delaunay::Delaunay::triangulate(points);
+    auto path = snapshot_path("delaunay_corrupt.snapshot");
+
+    // Offsets in the header: magic, version and endianness, then the vertex, edge and face counts, the hull edge
+    // and the (offset, size) pairs of the sections
+    auto corrupt = [&](std::vector<std::pair<std::streamoff, std::uint64_t>> const &values) {
+        original.save(path);
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        for (auto const &[offset, value] : values) {
+            file.seekp(offset);
+            file.write(reinterpret_cast<char const *>(&value), sizeof(value));
+        }
+    };
+    auto section_size = [](std::streamoff section) { return 48 + 16 * section + 8; };
+
+    // 4 * edge count wraps around to 0, which matches emptied edge sections
+    corrupt({{24, std::uint64_t{1} << 62}, {section_size(1), 0}, {section_size(2), 0}, {section_size(3), 0}});
+    ASSERT_THROW(std::ignore = delaunay::Delaunay::load(path), std::runtime_error);
+
+    // The hull edge must be a primary quarter edge
+    auto const hull_id = original.get_convex_hull().front()->id();
+    corrupt({{40, hull_id + 1}});
+    ASSERT_THROW(std::ignore = delaunay::Delaunay::load(path), std::runtime_error);
+
+    // Edge states beyond PROCESSED
+    original.save(path);
+    std::uint64_t states_offset = 0;
+    {
+        std::ifstream file(path, std::ios::binary);
+        file.seekg(48 + 3 * 16);
+        file.read(reinterpret_cast<char *>(&states_offset), sizeof(states_offset));
+    }
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(states_offset));
+        file.put(static_cast<char>(7));
+    }
+    ASSERT_THROW(std::ignore = delaunay::Delaunay::load(path), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "delaunay/delaunay.hpp"
+#include "delaunay/sweep_hull.hpp"
+#include "random_points.hpp"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace {
+    /**
+     * Edges as sorted pairs of input indices, works with QuadEdge* and SweepHull::HalfEdge
+     */
+    template<class Edges, class Origin>
+    auto edge_set(Edges const &edges, Origin const &input_index) -> std::set<std::pair<std::size_t, std::size_t>> {
+        std::set<std::pair<std::size_t, std::size_t>> result;
+        for (auto const &edge : edges) {
+            if (!edge->is_deleted()) {
+                std::size_t const a = input_index(edge->origin_index());
+                std::size_t const b = input_index(edge->destination_index());
+                result.emplace(std::min(a, b), std::max(a, b));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Number of edge directions with the outer face on their left, works with QuadEdge* and SweepHull::HalfEdge
+     */
+    template<class Edges>
+    auto outer_face_edges(Edges const &edges) -> std::size_t {
+        std::size_t count = 0;
+        for (auto const &edge : edges) {
+            if (!edge->is_deleted()) {
+                count += edge->left_face_index() == delaunay::QuadEdge::INVALID_INDEX ? 1 : 0;
+                count += edge->sym()->left_face_index() == delaunay::QuadEdge::INVALID_INDEX ? 1 : 0;
+            }
+        }
+        return count;
+    }
+}// namespace
+
+TEST(SweepHull, MatchesDelaunay) {
+    auto const points = random_points(5000);
+    auto const sweep = delaunay::SweepHull::triangulate(points);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+
+    auto const &origins = triangulation.get_vertex_origins();
+    auto const expected = edge_set(triangulation.get_primary_edges(), [&origins](std::size_t v) { return origins[v]; });
+    auto const actual = edge_set(sweep.get_primary_edges(), [](std::size_t v) { return v; });
+    ASSERT_EQ(actual, expected);
+
+    ASSERT_EQ(sweep.get_triangles().size(), triangulation.get_faces().size());
+    ASSERT_EQ(sweep.get_hull().size(), triangulation.get_convex_hull().size());
+}
+
+TEST(SweepHull, NavigatesLikeQuadEdges) {
+    auto const points = random_points(1000);
+    auto const sweep = delaunay::SweepHull::triangulate(points);
+
+    for (auto const &edge : sweep.get_primary_edges()) {
+        ASSERT_EQ(edge.sym().sym(), edge);
+        ASSERT_EQ(edge.sym().origin_index(), edge.destination_index());
+
+        // Walking around the origin returns to the edge, the faces are triangles except the outer face
+        auto current = edge;
+        std::size_t degree = 0;
+        do {
+            ASSERT_EQ(current.origin_index(), edge.origin_index());
+            if (current.is_left_face_triangle()) {
+                ASSERT_EQ(current.left_face_next().left_face_next().left_face_next(), current);
+                ASSERT_TRUE(delaunay::point_t::counter_clock_wise(current.origin(), current.destination(),
+                                                                  current.left_face_next().destination()));
+            }
+            ASSERT_EQ(current.orbit_next().orbit_prev(), current);
+            current = current.orbit_next();
+            degree++;
+        } while (current != edge && degree <= points.size());
+        ASSERT_EQ(current, edge);
+    }
+
+    // The outer face runs along the hull
+    auto const hull = sweep.get_convex_hull();
+    ASSERT_EQ(hull.size(), sweep.get_hull().size());
+    auto outer = hull.front().sym();
+    for (std::size_t i = 0; i < hull.size(); i++) {
+        ASSERT_EQ(outer.left_face_index(), delaunay::QuadEdge::INVALID_INDEX);
+        outer = outer.left_face_next();
+    }
+    ASSERT_EQ(outer, hull.front().sym());
+}
+
+TEST(SweepHull, SkipsDuplicatesAndCollinearPoints) {
+    std::vector<delaunay::point_t> points = {{0, 0}, {1, 0}, {0, 1}, {1, 1}, {1, 0}, {0, 0}};
+    auto const square = delaunay::SweepHull::triangulate(points);
+    ASSERT_EQ(square.get_triangles().size(), 6U);
+    ASSERT_EQ(square.get_hull().size(), 4U);
+
+    std::vector<delaunay::point_t> line = {{2, 2}, {0, 0}, {1, 1}, {1, 1}, {3, 3}};
+    auto const collinear = delaunay::SweepHull::triangulate(line);
+    ASSERT_TRUE(collinear.get_triangles().empty());
+    ASSERT_EQ(collinear.get_hull().size(), 4U);
+    ASSERT_TRUE(collinear.get_convex_hull().empty());
+}
+
+TEST(SweepHull, OuterFaceUsesTheQuadEdgeSentinel) {
+    auto const points = random_points(2000);
+    auto const sweep = delaunay::SweepHull::triangulate(points);
+    auto triangulation = delaunay::Delaunay::triangulate(std::span<delaunay::point_t const>(points));
+
+    // Generic code comparing against QuadEdge::INVALID_INDEX finds the hull on both engines
+    ASSERT_EQ(outer_face_edges(sweep.get_primary_edges()), sweep.get_hull().size());
+    ASSERT_EQ(outer_face_edges(triangulation.get_primary_edges()), triangulation.get_convex_hull().size());
+}
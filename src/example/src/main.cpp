@@ -1,8 +1,10 @@
 #include <iostream>
 #include <random>
+#include <tuple>
 #include <vector>
 #include <raylib.h>
 #include <raymath.h>
+#include "delaunay/async_triangulation.hpp"
 #include "delaunay/delaunay.hpp"
 
 void update_camera(Camera2D& camera) {
@@ -49,7 +51,7 @@ auto gen_random_points(size_t num_points) -> std::vector<delaunay::point_t> {
     return points;
 }
 
-void draw_edges(const std::vector<delaunay::QuadEdge*>& edges, Color color) {
+void draw_edges(std::span<delaunay::QuadEdge* const> edges, Color color) {
     for(auto* edge : edges) {
         if(edge->is_deleted()) {
             continue;
@@ -74,22 +76,29 @@ int main() {
 
     auto points = gen_random_points(1000);
 
+    // Triangulate in the background, the frame loop draws the latest finished triangulation
+    delaunay::AsyncTriangulation triangulator;
+    std::ignore = triangulator.submit(points);
+
     while (!WindowShouldClose()) {
         update_camera(camera);
 
         if(IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) {
             Vector2 pos = GetScreenToWorld2D(GetMousePosition(), camera);
             points.emplace_back(pos.x, pos.y);
+            std::ignore = triangulator.submit(points);
         }
 
-        delaunay::Delaunay triangulation = delaunay::Delaunay::triangulate(points);
+        auto triangulation = triangulator.latest();
 
         BeginDrawing();
             ClearBackground(RAYWHITE);
             BeginMode2D(camera);
 
-                draw_edges(triangulation.get_primary_edges(), BLACK);
-                draw_edges(triangulation.get_dual_edges(), ORANGE);
+                if (triangulation != nullptr) {
+                    draw_edges(triangulation->get_primary_edges(), BLACK);
+                    draw_edges(triangulation->get_dual_edges(), ORANGE);
+                }
 
 
             EndMode2D();